@@ -0,0 +1,178 @@
+#include "H264AccessUnitAssembler.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H264AccessUnitNalUnit::H264AccessUnitNalUnit()
+{
+    offset = 0;
+    size = 0;
+    first_slice_of_picture = 0;
+    res = false;
+}
+
+H264AccessUnit::H264AccessUnit()
+{
+    keyframe = 0;
+    reference = 0;
+}
+
+H264AccessUnitAssembler::H264AccessUnitAssembler(const AccessUnitCallback& callback, H264Deserialize::ptr deserialize)
+{
+    _callback = callback;
+    _deserialize = deserialize ? deserialize : std::make_shared<H264Deserialize>();
+    _feeder = std::make_shared<H26xByteStreamFeeder>([this](const uint8_t* data, size_t size) -> void
+    {
+        PushNalUnit(data, size);
+    });
+    _hasVcl = false;
+    _lastAuSize = 0;
+}
+
+bool H264AccessUnitAssembler::PushNalUnit(const uint8_t* data, size_t size)
+{
+    H264NalSyntax::ptr nal = _deserialize->MakeNalSyntax();
+    bool res = _deserialize->DeserializeNalSyntax(data, size, nal);
+    bool firstSliceOfPicture = false;
+    switch (nal->nal_unit_type)
+    {
+        case H264NaluType::MMP_H264_NALU_TYPE_AUD:
+        case H264NaluType::MMP_H264_NALU_TYPE_SPS:
+        case H264NaluType::MMP_H264_NALU_TYPE_PPS:
+        case H264NaluType::MMP_H264_NALU_TYPE_SEI:
+        case H264NaluType::MMP_H264_NALU_TYPE_PREFIX:
+        case H264NaluType::MMP_H264_NALU_TYPE_SUB_SPS:
+        case 16: /* reserved */
+        case 17: /* reserved */
+        case 18: /* reserved */
+        {
+            if (_hasVcl)
+            {
+                ReportAccessUnit();
+            }
+            break;
+        }
+        case H264NaluType::MMP_H264_NALU_TYPE_SLICE:
+        case H264NaluType::MMP_H264_NALU_TYPE_IDR:
+        {
+            // Hint : redundant coded pictures belong to the access unit of their primary coded picture
+            if (!nal->slice || nal->slice->redundant_pic_cnt > 0)
+            {
+                break;
+            }
+            firstSliceOfPicture = FirstVclNalUnitOfPrimaryCodedPicture(nal);
+            if (firstSliceOfPicture && _hasVcl)
+            {
+                ReportAccessUnit();
+            }
+            _hasVcl = true;
+            _prevNal = nal;
+            break;
+        }
+        default:
+            break;
+    }
+    if (!_au && _spareAu)
+    {
+        _au = _spareAu;
+        _spareAu = nullptr;
+    }
+    else if (!_au)
+    {
+        _au = std::make_shared<H264AccessUnit>();
+        _au->data.reserve(_lastAuSize);
+    }
+    if (firstSliceOfPicture)
+    {
+        _au->keyframe = nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_IDR;
+        _au->reference = nal->nal_ref_idc != 0;
+    }
+    H264AccessUnitNalUnit nalUnit;
+    _au->data.insert(_au->data.end(), {0x00, 0x00, 0x00, 0x01});
+    nalUnit.offset = _au->data.size();
+    nalUnit.size = size;
+    nalUnit.first_slice_of_picture = firstSliceOfPicture;
+    nalUnit.res = res;
+    nalUnit.nal = nal;
+    _au->data.insert(_au->data.end(), data, data + size);
+    _au->nals.push_back(nalUnit);
+    return res;
+}
+
+void H264AccessUnitAssembler::Feed(const uint8_t* data, size_t size)
+{
+    _feeder->Feed(data, size);
+}
+
+void H264AccessUnitAssembler::Flush()
+{
+    _feeder->Flush();
+    ReportAccessUnit();
+}
+
+void H264AccessUnitAssembler::Reset()
+{
+    _feeder->Reset();
+    _au = nullptr;
+    _hasVcl = false;
+    _prevNal = nullptr;
+}
+
+bool H264AccessUnitAssembler::FirstVclNalUnitOfPrimaryCodedPicture(H264NalSyntax::ptr nal)
+{
+    // See also : ISO 14496/10(2020) - 7.4.1.2.4 Detection of the first VCL NAL unit of a primary coded picture
+    // Hint : syntax elements not present are 0, so they may be compared whatever pic_order_cnt_type is
+    if (!_prevNal)
+    {
+        return true;
+    }
+    H264SliceHeaderSyntax::ptr prev = _prevNal->slice;
+    H264SliceHeaderSyntax::ptr cur = nal->slice;
+    uint8_t prevIdrPicFlag = _prevNal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_IDR;
+    uint8_t curIdrPicFlag = nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_IDR;
+    if (prev->frame_num != cur->frame_num ||
+        prev->pic_parameter_set_id != cur->pic_parameter_set_id ||
+        prev->field_pic_flag != cur->field_pic_flag ||
+        prev->bottom_field_flag != cur->bottom_field_flag ||
+        (_prevNal->nal_ref_idc != nal->nal_ref_idc && (_prevNal->nal_ref_idc == 0 || nal->nal_ref_idc == 0)) ||
+        prev->pic_order_cnt_lsb != cur->pic_order_cnt_lsb ||
+        prev->delta_pic_order_cnt_bottom != cur->delta_pic_order_cnt_bottom ||
+        prev->delta_pic_order_cnt[0] != cur->delta_pic_order_cnt[0] ||
+        prev->delta_pic_order_cnt[1] != cur->delta_pic_order_cnt[1] ||
+        prevIdrPicFlag != curIdrPicFlag ||
+        (prevIdrPicFlag && curIdrPicFlag && prev->idr_pic_id != cur->idr_pic_id)
+    )
+    {
+        return true;
+    }
+    return false;
+}
+
+void H264AccessUnitAssembler::ReportAccessUnit()
+{
+    H264AccessUnit::ptr au = _au;
+    _au = nullptr;
+    _hasVcl = false;
+    if (au)
+    {
+        _lastAuSize = au->data.size();
+    }
+    if (au && _callback)
+    {
+        _callback(au);
+    }
+    // Hint : once released by the callback, data and nals are cleared but keep their capacity
+    if (au && au.use_count() == 1)
+    {
+        au->keyframe = 0;
+        au->reference = 0;
+        au->data.clear();
+        au->nals.clear();
+        _spareAu = au;
+    }
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
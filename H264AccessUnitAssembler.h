@@ -0,0 +1,113 @@
+//
+// H264AccessUnitAssembler.h
+//
+// Library: Codec
+// Package: H264
+// Module:  H264
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "H264Common.h"
+#include "H264Deserialize.h"
+#include "H26xByteStreamFeeder.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief one NAL unit of an access unit, a view into H264AccessUnit::data
+ */
+class H264AccessUnitNalUnit
+{
+public:
+    H264AccessUnitNalUnit();
+    ~H264AccessUnitNalUnit() = default;
+public:
+    size_t  offset;                 // offset in H264AccessUnit::data of the NAL unit (start code excluded)
+    size_t  size;
+    uint8_t first_slice_of_picture; // picture boundary, first VCL NAL unit of the primary coded picture
+    bool    res;                    // result of DeserializeNalSyntax
+    H264NalSyntax::ptr nal;
+};
+
+/**
+ * @sa ISO 14496/10(2020) - 7.4.1.2.3 Order of NAL units and coded pictures and association to access units
+ */
+class H264AccessUnit
+{
+public:
+    using ptr = std::shared_ptr<H264AccessUnit>;
+public:
+    H264AccessUnit();
+    ~H264AccessUnit() = default;
+public:
+    uint8_t keyframe;  // IDR picture
+    uint8_t reference; // nal_ref_idc of the primary coded picture is not 0
+    /**
+     * @brief NAL units of the access unit, each one preceded by a 4 bytes start code (Annex B)
+     */
+    std::vector<uint8_t>               data;
+    std::vector<H264AccessUnitNalUnit> nals;
+};
+
+/**
+ * @brief group NAL units into access units, one batch per primary coded picture
+ * @note  1 - the first of AUD, SPS, PPS, SEI, NAL unit types 14 to 18 or the first VCL NAL unit of a primary coded
+ *            picture, following the last VCL NAL unit of a primary coded picture, starts a new access unit
+ *        2 - the first VCL NAL unit of a primary coded picture is detected by comparing its slice header with the
+ *            previous one, see ISO 14496/10(2020) - 7.4.1.2.4 Detection of the first VCL NAL unit of a primary coded picture
+ *        3 - an access unit is reported once the next one begins, or on Flush()
+ *        4 - slice headers are required, keep slices, SPS and PPS in H264Deserialize::SetNalUnitTypeMask()
+ *        5 - NAL unit syntax is made by the deserializer, see also H264Deserialize::SetSyntaxPool(); an access unit
+ *            no longer referenced once the callback returns is recycled for the next one
+ */
+class H264AccessUnitAssembler
+{
+public:
+    using ptr = std::shared_ptr<H264AccessUnitAssembler>;
+    using AccessUnitCallback = std::function<void(H264AccessUnit::ptr au)>;
+public:
+    /**
+     * @param deserialize : nullptr to use a private one
+     */
+    explicit H264AccessUnitAssembler(const AccessUnitCallback& callback, H264Deserialize::ptr deserialize = nullptr);
+    ~H264AccessUnitAssembler() = default;
+public:
+    /**
+     * @brief push one NAL unit (without start code), such as from H26xRtpDepacketizer or a length prefixed sample
+     * @note  data is copied into the access unit
+     */
+    bool PushNalUnit(const uint8_t* data, size_t size);
+    /**
+     * @brief push the next chunk of byte stream (Annex B), chunks may be of any size
+     */
+    void Feed(const uint8_t* data, size_t size);
+    /**
+     * @brief end of stream, the last access unit (if any) is reported
+     */
+    void Flush();
+    void Reset();
+private:
+    bool FirstVclNalUnitOfPrimaryCodedPicture(H264NalSyntax::ptr nal);
+    void ReportAccessUnit();
+private:
+    AccessUnitCallback        _callback;
+    H264Deserialize::ptr      _deserialize;
+    H26xByteStreamFeeder::ptr _feeder;
+    H264AccessUnit::ptr       _au;
+    H264AccessUnit::ptr       _spareAu;  // last access unit reported and released, recycled with its capacity
+    size_t                    _lastAuSize;
+    bool                      _hasVcl;   // _au holds a VCL NAL unit of the primary coded picture
+    H264NalSyntax::ptr        _prevNal;  // last VCL NAL unit of the primary coded picture
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -92,26 +92,65 @@ H264NalMvcSyntax::H264NalMvcSyntax()
 }
 
 H264SeiPictureTimingSyntax::H264SeiPictureTimingSyntax()
+{
+    Reset();
+}
+
+void H264SeiPictureTimingSyntax::Reset()
 {
     cpb_removal_delay = 0;
     dpb_output_delay = 0;
-    pic_struct = 0;   
+    pic_struct = 0;
+    clock_timestamp_flag.fill(0);
+    ct_type.fill(0);
+    nuit_field_based_flag.fill(0);
+    counting_type.fill(0);
+    full_timestamp_flag.fill(0);
+    discontinuity_flag.fill(0);
+    cnt_dropped_flag.fill(0);
+    n_frames.fill(0);
+    seconds_value.fill(0);
+    minutes_value.fill(0);
+    hours_value.fill(0);
+    seconds_flag.fill(0);
+    minutes_flag.fill(0);
+    hours_flag.fill(0);
+    time_offset.fill(0);
 }
 
 H264SeiBufferPeriodSyntax::H264SeiBufferPeriodSyntax()
+{
+    Reset();
+}
+
+void H264SeiBufferPeriodSyntax::Reset()
 {
     seq_parameter_set_id = 0;
+    initial_cpb_removal_delay.clear();
+    initial_cpb_removal_delay_offset.clear();
 }
 
 H264SeiUserDataRegisteredSyntax::H264SeiUserDataRegisteredSyntax()
+{
+    Reset();
+}
+
+void H264SeiUserDataRegisteredSyntax::Reset()
 {
     itu_t_t35_country_code = 0;
     itu_t_t35_country_code_extension_byte = 0;
+    itu_t_t35_payload_byte.clear();
 }
 
 H264SeiUserDataUnregisteredSyntax::H264SeiUserDataUnregisteredSyntax()
+{
+    Reset();
+}
+
+void H264SeiUserDataUnregisteredSyntax::Reset()
 {
     memset(uuid_iso_iec_11578, 0, sizeof(uuid_iso_iec_11578));
+    user_data_payload_byte.clear();
 }
 
 H264SeiRecoveryPointSyntax::H264SeiRecoveryPointSyntax()
@@ -123,6 +162,11 @@ H264SeiRecoveryPointSyntax::H264SeiRecoveryPointSyntax()
 }
 
 H264SeiFilmGrainSyntax::H264SeiFilmGrainSyntax()
+{
+    Reset();
+}
+
+void H264SeiFilmGrainSyntax::Reset()
 {
     film_grain_characteristics_cancel_flag = 0;
     film_grain_model_id = 0;
@@ -139,6 +183,24 @@ H264SeiFilmGrainSyntax::H264SeiFilmGrainSyntax()
     blending_mode_id = 0;
     log2_scale_factor = 0;
     film_grain_characteristics_repetition_period = 0;
+    intensity_interval_lower_bound.clear();
+    intensity_interval_upper_bound.clear();
+    comp_model_value.clear();
+}
+
+H264DecoderConfigurationRecordSyntax::H264DecoderConfigurationRecordSyntax()
+{
+    configurationVersion = 0;
+    AVCProfileIndication = 0;
+    profile_compatibility = 0;
+    AVCLevelIndication = 0;
+    lengthSizeMinusOne = 3;
+    numOfSequenceParameterSets = 0;
+    numOfPictureParameterSets = 0;
+    chroma_format = 1;
+    bit_depth_luma_minus8 = 0;
+    bit_depth_chroma_minus8 = 0;
+    numOfSequenceParameterSetExt = 0;
 }
 
 H264ContextSyntax::H264ContextSyntax()
@@ -240,22 +302,53 @@ H264MvcVuiSyntax::H264MvcVuiSyntax()
 }
 
 H264ReferencePictureListModificationSyntax::H264ReferencePictureListModificationSyntax()
+{
+    Reset();
+}
+
+void H264ReferencePictureListModificationSyntax::Reset()
 {
     ref_pic_list_modification_flag_l0 = 0;
     ref_pic_list_modification_flag_l1 = 0;
+    modification_of_pic_nums_idcs.clear();
+    modification_of_pic_nums_idcs_datas.clear();
 }
 
 H264PredictionWeightTableSyntax::H264PredictionWeightTableSyntax()
+{
+    Reset();
+}
+
+void H264PredictionWeightTableSyntax::Reset()
 {
     luma_log2_weight_denom = 0;
     chroma_log2_weight_denom = 0;
+    luma_weight_l0_flag.fill(0);
+    luma_weight_l0.fill(0);
+    luma_offset_l0.fill(0);
+    chroma_weight_l0_flag.fill(0);
+    chroma_weight_l0.fill({0, 0});
+    chroma_offset_l0.fill({0, 0});
+    luma_weight_l1_flag.fill(0);
+    luma_weight_l1.fill(0);
+    luma_offset_l1.fill(0);
+    chroma_weight_l1_flag.fill(0);
+    chroma_weight_l1.fill({0, 0});
+    chroma_offset_l1.fill({0, 0});
 }
 
 H264DecodedReferencePictureMarkingSyntax::H264DecodedReferencePictureMarkingSyntax()
+{
+    Reset();
+}
+
+void H264DecodedReferencePictureMarkingSyntax::Reset()
 {
     no_output_of_prior_pics_flag = 0;
     long_term_reference_flag = 0;
     adaptive_ref_pic_marking_mode_flag = 0;
+    memory_management_control_operations.clear();
+    memory_management_control_operations_datas.clear();
 }
 
 H264SubSpsSyntax::H264SubSpsSyntax()
@@ -284,6 +377,17 @@ H264SpsSyntax::H264SpsSyntax()
     bit_depth_chroma_minus8 = 0;
     qpprime_y_zero_transform_bypass_flag = 0;
     seq_scaling_matrix_present_flag = 0;
+    seq_scaling_list_present_flag.fill(0);
+    for (auto& scalingList : ScalingList4x4)
+    {
+        scalingList.fill(0);
+    }
+    UseDefaultScalingMatrix4x4Flag.fill(0);
+    for (auto& scalingList : ScalingList8x8)
+    {
+        scalingList.fill(0);
+    }
+    UseDefaultScalingMatrix8x8Flag.fill(0);
     log2_max_frame_num_minus4 = 0;
     pic_order_cnt_type = 0;
     log2_max_pic_order_cnt_lsb_minus4 = 0;
@@ -326,6 +430,17 @@ H264PpsSyntax::H264PpsSyntax()
     redundant_pic_cnt_present_flag = 0;
     transform_8x8_mode_flag = 0;
     pic_scaling_matrix_present_flag = 0;
+    pic_scaling_list_present_flag.fill(0);
+    for (auto& scalingList : ScalingList4x4)
+    {
+        scalingList.fill(0);
+    }
+    UseDefaultScalingMatrix4x4Flag.fill(0);
+    for (auto& scalingList : ScalingList8x8)
+    {
+        scalingList.fill(0);
+    }
+    UseDefaultScalingMatrix8x8Flag.fill(0);
     second_chroma_qp_index_offset  = 0;
 }
 
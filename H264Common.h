@@ -10,12 +10,15 @@
 
 #include <set>
 #include <map>
+#include <array>
 #include <string>
 #include <vector>
 #include <memory>
 #include <cstdint>
 #include <unordered_map>
 
+#include "H26xUltis.h"
+
 namespace Mmp
 {
 namespace Codec
@@ -326,6 +329,7 @@ public:
 public:
     H264SeiBufferPeriodSyntax();
     ~H264SeiBufferPeriodSyntax() = default;
+    void Reset();
 public:
     uint32_t seq_parameter_set_id;
     std::vector<uint32_t> initial_cpb_removal_delay;
@@ -342,25 +346,27 @@ public:
 public:
     H264SeiPictureTimingSyntax();
     ~H264SeiPictureTimingSyntax() = default;
+    void Reset();
 public:
     uint32_t  cpb_removal_delay;
     uint32_t  dpb_output_delay;
     uint8_t   pic_struct;
-    std::vector<uint8_t>   clock_timestamp_flag;
-    std::vector<uint8_t>   ct_type;
-    std::vector<uint8_t>   nuit_field_based_flag;
-    std::vector<uint8_t>   counting_type;
-    std::vector<uint8_t>   full_timestamp_flag;
-    std::vector<uint8_t>   discontinuity_flag;
-    std::vector<uint8_t>   cnt_dropped_flag;
-    std::vector<uint8_t>  n_frames;
-    std::vector<uint8_t>   seconds_value;
-    std::vector<uint8_t>   minutes_value;
-    std::vector<uint8_t>   hours_value;
-    std::vector<uint8_t>   seconds_flag;
-    std::vector<uint8_t>   minutes_flag;
-    std::vector<uint8_t>   hours_flag;
-    std::vector<int32_t>  time_offset;
+    // Hint : NumClockTS entries are valid, see also Table D-1 – Interpretation of pic_struct
+    std::array<uint8_t, 3>   clock_timestamp_flag;
+    std::array<uint8_t, 3>   ct_type;
+    std::array<uint8_t, 3>   nuit_field_based_flag;
+    std::array<uint8_t, 3>   counting_type;
+    std::array<uint8_t, 3>   full_timestamp_flag;
+    std::array<uint8_t, 3>   discontinuity_flag;
+    std::array<uint8_t, 3>   cnt_dropped_flag;
+    std::array<uint8_t, 3>   n_frames;
+    std::array<uint8_t, 3>   seconds_value;
+    std::array<uint8_t, 3>   minutes_value;
+    std::array<uint8_t, 3>   hours_value;
+    std::array<uint8_t, 3>   seconds_flag;
+    std::array<uint8_t, 3>   minutes_flag;
+    std::array<uint8_t, 3>   hours_flag;
+    std::array<int32_t, 3>   time_offset;
 };
 
 /**
@@ -373,6 +379,7 @@ public:
 public:
     H264SeiUserDataRegisteredSyntax();
     ~H264SeiUserDataRegisteredSyntax() = default;
+    void Reset();
 public:
     uint8_t  itu_t_t35_country_code;
     uint8_t  itu_t_t35_country_code_extension_byte;
@@ -389,6 +396,7 @@ public:
 public:
     H264SeiUserDataUnregisteredSyntax();
     ~H264SeiUserDataUnregisteredSyntax() = default;
+    void Reset();
 public:
     uint8_t uuid_iso_iec_11578[16];
     std::vector<uint8_t> user_data_payload_byte;
@@ -421,6 +429,7 @@ public:
 public:
     H264SeiFilmGrainSyntax();
     ~H264SeiFilmGrainSyntax() = default;
+    void Reset();
 public:
     uint8_t  film_grain_characteristics_cancel_flag;
     uint8_t  film_grain_model_id;
@@ -677,6 +686,7 @@ public:
 public:
     H264ReferencePictureListModificationSyntax();
     ~H264ReferencePictureListModificationSyntax() = default;
+    void Reset();
 public:
     uint8_t   ref_pic_list_modification_flag_l0;
     uint8_t   ref_pic_list_modification_flag_l1;
@@ -699,21 +709,23 @@ public:
 public:
     H264PredictionWeightTableSyntax();
     ~H264PredictionWeightTableSyntax() = default;
+    void Reset();
 public:
     uint32_t  luma_log2_weight_denom;
     uint32_t  chroma_log2_weight_denom;
-    std::vector<uint8_t> luma_weight_l0_flag;
-    std::vector<int32_t> luma_weight_l0;
-    std::vector<int32_t> luma_offset_l0;
-    std::vector<uint8_t> chroma_weight_l0_flag;
-    std::vector<std::vector<int32_t>>  chroma_weight_l0;
-    std::vector<std::vector<int32_t>>  chroma_offset_l0;
-    std::vector<uint8_t> luma_weight_l1_flag;
-    std::vector<int32_t> luma_weight_l1;
-    std::vector<int32_t> luma_offset_l1;
-    std::vector<uint8_t> chroma_weight_l1_flag;
-    std::vector<std::vector<int32_t>>  chroma_weight_l1;
-    std::vector<std::vector<int32_t>>  chroma_offset_l1;
+    // Hint : num_ref_idx_lX_active_minus1 + 1 entries are valid, num_ref_idx_lX_active_minus1 is at most 31
+    std::array<uint8_t, 32> luma_weight_l0_flag;
+    std::array<int32_t, 32> luma_weight_l0;
+    std::array<int32_t, 32> luma_offset_l0;
+    std::array<uint8_t, 32> chroma_weight_l0_flag;
+    std::array<std::array<int32_t, 2>, 32>  chroma_weight_l0;
+    std::array<std::array<int32_t, 2>, 32>  chroma_offset_l0;
+    std::array<uint8_t, 32> luma_weight_l1_flag;
+    std::array<int32_t, 32> luma_weight_l1;
+    std::array<int32_t, 32> luma_offset_l1;
+    std::array<uint8_t, 32> chroma_weight_l1_flag;
+    std::array<std::array<int32_t, 2>, 32>  chroma_weight_l1;
+    std::array<std::array<int32_t, 2>, 32>  chroma_offset_l1;
 };
 
 /**
@@ -726,6 +738,7 @@ public:
 public:
     H264DecodedReferencePictureMarkingSyntax();
     ~H264DecodedReferencePictureMarkingSyntax() = default;
+    void Reset();
 public:
     uint8_t   no_output_of_prior_pics_flag;
     uint8_t   long_term_reference_flag;
@@ -787,11 +800,11 @@ public:
     uint32_t   bit_depth_chroma_minus8;
     uint8_t    qpprime_y_zero_transform_bypass_flag;
     uint8_t    seq_scaling_matrix_present_flag;
-    std::vector<uint8_t> seq_scaling_list_present_flag;
-    std::vector<std::vector<int32_t>> ScalingList4x4;
-    std::vector<int32_t> UseDefaultScalingMatrix4x4Flag;
-    std::vector<std::vector<int32_t>> ScalingList8x8;
-    std::vector<int32_t> UseDefaultScalingMatrix8x8Flag;
+    std::array<uint8_t, 12> seq_scaling_list_present_flag;
+    std::array<std::array<int32_t, 16>, 6> ScalingList4x4;
+    std::array<int32_t, 6> UseDefaultScalingMatrix4x4Flag;
+    std::array<std::array<int32_t, 64>, 6> ScalingList8x8;
+    std::array<int32_t, 6> UseDefaultScalingMatrix8x8Flag;
     uint32_t   log2_max_frame_num_minus4;
     uint32_t   pic_order_cnt_type;
     uint32_t   log2_max_pic_order_cnt_lsb_minus4;
@@ -854,11 +867,11 @@ public:
     uint8_t  redundant_pic_cnt_present_flag;
     uint8_t  transform_8x8_mode_flag;
     uint8_t  pic_scaling_matrix_present_flag;
-    std::vector<uint8_t> pic_scaling_list_present_flag;
-    std::vector<std::vector<int32_t>> ScalingList4x4;
-    std::vector<int32_t> UseDefaultScalingMatrix4x4Flag;
-    std::vector<std::vector<int32_t>> ScalingList8x8;
-    std::vector<int32_t> UseDefaultScalingMatrix8x8Flag;
+    std::array<uint8_t, 12> pic_scaling_list_present_flag;
+    std::array<std::array<int32_t, 16>, 6> ScalingList4x4;
+    std::array<int32_t, 6> UseDefaultScalingMatrix4x4Flag;
+    std::array<std::array<int32_t, 64>, 6> ScalingList8x8;
+    std::array<int32_t, 6> UseDefaultScalingMatrix8x8Flag;
     int32_t second_chroma_qp_index_offset;
 };
 
@@ -929,6 +942,34 @@ public:
     H264SliceHeaderSyntax::ptr  slice;
 };
 
+/**
+ * @brief decoder configuration of length prefixed (AVCC) streams, such as avcC box of MP4
+ * @sa    ISO 14496/15(2019) - 5.3.3.1 AVC decoder configuration record
+ */
+class H264DecoderConfigurationRecordSyntax
+{
+public:
+    using ptr = std::shared_ptr<H264DecoderConfigurationRecordSyntax>;
+public:
+    H264DecoderConfigurationRecordSyntax();
+    ~H264DecoderConfigurationRecordSyntax() = default;
+public:
+    uint8_t  configurationVersion;
+    uint8_t  AVCProfileIndication;
+    uint8_t  profile_compatibility;
+    uint8_t  AVCLevelIndication;
+    uint8_t  lengthSizeMinusOne;
+    uint8_t  numOfSequenceParameterSets;
+    std::vector<H264NalSyntax::ptr> sequenceParameterSetNALUnits;
+    uint8_t  numOfPictureParameterSets;
+    std::vector<H264NalSyntax::ptr> pictureParameterSetNALUnits;
+    uint8_t  chroma_format;
+    uint8_t  bit_depth_luma_minus8;
+    uint8_t  bit_depth_chroma_minus8;
+    uint8_t  numOfSequenceParameterSetExt;
+    std::vector<H264NalSyntax::ptr> sequenceParameterSetExtNALUnits;
+};
+
 class H264ContextSyntax
 {
 public:
@@ -942,6 +983,9 @@ public:
     std::unordered_map<int32_t, H264PpsSyntax::ptr> ppsSet;
     H264SpsSyntax::ptr sps;
     H264PpsSyntax::ptr pps;
+    // Hint : NAL units spsSet and ppsSet are deserialized from, see also H264Deserialize::ParameterSetChanged()
+    std::unordered_map<int32_t, H26xParameterSetData::ptr> spsData;
+    std::unordered_map<int32_t, H26xParameterSetData::ptr> ppsData;
 };
 
 class H264RplcContext
@@ -34,6 +34,9 @@ namespace Codec
 H264Deserialize::H264Deserialize()
 {
     _contex = std::make_shared<H264ContextSyntax>();
+    _parameterSetChanged = false;
+    _nalUnitTypeMask = 0xFFFFFFFF;
+    _seiPayloadTypeMask.set();
 }
 
 H264Deserialize::~H264Deserialize()
@@ -41,50 +44,454 @@ H264Deserialize::~H264Deserialize()
 
 }
 
+bool H264Deserialize::DeserializeByteStream(const uint8_t* data, size_t size, std::vector<H264NalSyntax::ptr>& nals)
+{
+    std::vector<H26xNalUnitInfo> infos;
+    H26xNalSplitter::Split(data, size, infos);
+    bool res = true;
+    for (const H26xNalUnitInfo& info : infos)
+    {
+        if (!NalUnitTypeEnabled(info.header & 0x1F))
+        {
+            continue;
+        }
+        H264NalSyntax::ptr nal = MakeNalSyntax();
+        if (!DeserializeNalSyntax(data + info.offset, info.size, nal))
+        {
+            res = false;
+        }
+        nals.push_back(nal);
+    }
+    return res;
+}
+
+H264LazyNalUnit::ptr H264Deserialize::DeserializeLazyNalUnit(const uint8_t* data, size_t size)
+{
+    if (size < 1)
+    {
+        H26x_LOG_ERROR << "[H264] empty NAL unit" << H26x_LOG_TERMINATOR;
+        return nullptr;
+    }
+    // Hint : lazy NAL units may be released by any thread, never carve them from the arena
+    H26xArena::ptr arena = std::move(_arena);
+    // See also : ISO 14496/10(2020) - 7.3.1 NAL unit syntax
+    uint8_t nal_ref_idc = (data[0] >> 5) & 0x03;
+    uint8_t nal_unit_type = data[0] & 0x1F;
+    H264LazyNalUnit::ptr lazyNal;
+    if (nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SPS || nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_PPS ||
+        nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SUB_SPS ||
+        !NalUnitTypeEnabled(nal_unit_type)
+    )
+    {
+        // Hint : parameter sets are deserialized up front, later NAL units depend on them,
+        //        disabled NAL unit types only carry the header
+        lazyNal = std::make_shared<H264LazyNalUnit>(data, size, nullptr);
+        lazyNal->_nal = MakeNalSyntax();
+        lazyNal->_res = DeserializeNalSyntax(data, size, lazyNal->_nal);
+        lazyNal->_deserialized = true;
+    }
+    else
+    {
+        if (!_lazyContex)
+        {
+            _lazyContex = std::make_shared<H264ContextSyntax>(*_contex);
+        }
+        lazyNal = std::make_shared<H264LazyNalUnit>(data, size, _lazyContex);
+        lazyNal->_nal = MakeNalSyntax();
+    }
+    lazyNal->nal_ref_idc = nal_ref_idc;
+    lazyNal->nal_unit_type = nal_unit_type;
+    lazyNal->_nalUnitTypeMask = _nalUnitTypeMask;
+    lazyNal->_seiPayloadTypeMask = _seiPayloadTypeMask;
+    _arena = std::move(arena);
+    return lazyNal;
+}
+
+H264ContextSyntax::ptr H264Deserialize::GetContext()
+{
+    return _contex;
+}
+
+void H264Deserialize::SetContext(H264ContextSyntax::ptr contex)
+{
+    _contex = contex;
+    _lazyContex = nullptr;
+}
+
+bool H264Deserialize::ParameterSetChanged()
+{
+    return _parameterSetChanged;
+}
+
+void H264Deserialize::SetParameterSetStore(H264ParameterSetStore::ptr store)
+{
+    _parameterSetStore = store;
+}
+
+void H264Deserialize::SetArena(H26xArena::ptr arena)
+{
+    _arena = arena;
+}
+
+void H264Deserialize::SetSyntaxPool(H264SyntaxPool::ptr pool)
+{
+    _pool = pool;
+}
+
+void H264Deserialize::SetNalUnitTypeMask(uint32_t mask)
+{
+    _nalUnitTypeMask = mask;
+}
+
+void H264Deserialize::SetSeiPayloadTypeMask(const std::bitset<256>& mask)
+{
+    _seiPayloadTypeMask = mask;
+}
+
+bool H264Deserialize::NalUnitTypeEnabled(uint8_t nal_unit_type)
+{
+    return (_nalUnitTypeMask >> nal_unit_type) & 0x01;
+}
+
+bool H264Deserialize::ReuseParameterSet(const uint8_t* data, size_t size, uint64_t hash, H264NalSyntax::ptr nal)
+{
+    uint8_t nal_unit_type = data[0] & 0x1F;
+    std::unordered_map<int32_t, H26xParameterSetData::ptr>& dataSet = nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SPS ? _contex->spsData : _contex->ppsData;
+    for (auto& psData : dataSet)
+    {
+        if (!psData.second->Equal(data, size, hash))
+        {
+            continue;
+        }
+        nal->nal_ref_idc = (data[0] >> 5) & 0x03;
+        nal->nal_unit_type = nal_unit_type;
+        if (nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SPS)
+        {
+            nal->sps = _contex->spsSet[psData.first];
+            if (_contex->sps != nal->sps)
+            {
+                _contex->sps = nal->sps;
+                _lazyContex = nullptr;
+            }
+        }
+        else
+        {
+            nal->pps = _contex->ppsSet[psData.first];
+            if (_contex->pps != nal->pps)
+            {
+                _contex->pps = nal->pps;
+                _lazyContex = nullptr;
+            }
+        }
+        _parameterSetChanged = false;
+        return true;
+    }
+    return false;
+}
+
+bool H264Deserialize::FindParameterSet(const uint8_t* data, size_t size, uint64_t hash, H264NalSyntax::ptr nal)
+{
+    uint8_t nal_unit_type = data[0] & 0x1F;
+    H26xParameterSetData::ptr psData;
+    if (nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SPS)
+    {
+        H264SpsSyntax::ptr sps = _parameterSetStore->spsTable.Find(data, size, hash, nullptr, psData);
+        if (!sps)
+        {
+            return false;
+        }
+        nal->sps = sps;
+        StoreSps(sps);
+        _contex->spsData[sps->seq_parameter_set_id] = psData;
+    }
+    else
+    {
+        auto dependencyOf = [this](const H264PpsSyntax::ptr& pps) -> std::shared_ptr<void>
+        {
+            auto it = _contex->spsSet.find(pps->seq_parameter_set_id);
+            return it != _contex->spsSet.end() ? it->second : nullptr;
+        };
+        H264PpsSyntax::ptr pps = _parameterSetStore->ppsTable.Find(data, size, hash, dependencyOf, psData);
+        if (!pps)
+        {
+            return false;
+        }
+        nal->pps = pps;
+        StorePps(pps);
+        _contex->ppsData[pps->pic_parameter_set_id] = psData;
+    }
+    nal->nal_ref_idc = (data[0] >> 5) & 0x03;
+    nal->nal_unit_type = nal_unit_type;
+    return true;
+}
+
+void H264Deserialize::InternParameterSet(const uint8_t* data, size_t size, uint64_t hash, H264NalSyntax::ptr nal)
+{
+    H26xParameterSetData::ptr psData = std::make_shared<H26xParameterSetData>(data, size, hash);
+    if (nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SPS)
+    {
+        if (_parameterSetStore)
+        {
+            H264SpsSyntax::ptr sps = _parameterSetStore->spsTable.Intern(psData, nal->sps, nullptr);
+            if (sps != nal->sps)
+            {
+                nal->sps = sps;
+                StoreSps(sps);
+            }
+        }
+        _contex->spsData[nal->sps->seq_parameter_set_id] = psData;
+    }
+    else
+    {
+        if (_parameterSetStore)
+        {
+            H264PpsSyntax::ptr pps = _parameterSetStore->ppsTable.Intern(psData, nal->pps, _contex->spsSet[nal->pps->seq_parameter_set_id]);
+            if (pps != nal->pps)
+            {
+                nal->pps = pps;
+                StorePps(pps);
+            }
+        }
+        _contex->ppsData[nal->pps->pic_parameter_set_id] = psData;
+    }
+}
+
+void H264Deserialize::StoreSps(H264SpsSyntax::ptr sps)
+{
+    _contex->spsSet[sps->seq_parameter_set_id] = sps;
+    _contex->sps = sps;
+    // Hint : PPS are deserialized against their SPS, those referring to this one are deserialized again,
+    //        see also ParameterSetChanged()
+    _contex->spsData.erase(sps->seq_parameter_set_id);
+    for (auto it = _contex->ppsData.begin(); it != _contex->ppsData.end();)
+    {
+        auto pps = _contex->ppsSet.find(it->first);
+        if (pps == _contex->ppsSet.end() || pps->second->seq_parameter_set_id == sps->seq_parameter_set_id)
+        {
+            it = _contex->ppsData.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+    _parameterSetChanged = true;
+    _lazyContex = nullptr;
+}
+
+void H264Deserialize::StorePps(H264PpsSyntax::ptr pps)
+{
+    _contex->ppsSet[pps->pic_parameter_set_id] = pps;
+    _contex->pps = pps;
+    _contex->ppsData.erase(pps->pic_parameter_set_id);
+    _parameterSetChanged = true;
+    _lazyContex = nullptr;
+}
+
+H264NalSyntax::ptr H264Deserialize::MakeNalSyntax()
+{
+    return _pool ? _pool->AcquireNalSyntax() : H26xMakeShared<H264NalSyntax>(_arena.get());
+}
+
+void H264Deserialize::SetNalUnitCallback(const NalUnitCallback& callback)
+{
+    _nalUnitCallback = callback;
+}
+
+void H264Deserialize::Feed(const uint8_t* data, size_t size)
+{
+    if (!_feeder)
+    {
+        _feeder = std::make_shared<H26xByteStreamFeeder>([this](const uint8_t* data, size_t size) -> void
+        {
+            if (size && !NalUnitTypeEnabled(data[0] & 0x1F))
+            {
+                return;
+            }
+            H264NalSyntax::ptr nal = MakeNalSyntax();
+            bool res = DeserializeNalSyntax(data, size, nal);
+            if (_nalUnitCallback)
+            {
+                _nalUnitCallback(res, nal);
+            }
+        });
+    }
+    _feeder->Feed(data, size);
+}
+
+void H264Deserialize::Flush()
+{
+    if (_feeder)
+    {
+        _feeder->Flush();
+    }
+}
+
+bool H264Deserialize::DeserializeDecoderConfigurationRecord(const uint8_t* data, size_t size, H264DecoderConfigurationRecordSyntax::ptr record)
+{
+    // See also : ISO 14496/15(2019) - 5.3.3.1.2 Syntax
+    auto deserializeParameterSets = [this, data, size](H26xBinaryReader::ptr br, uint8_t num, std::vector<H264NalSyntax::ptr>& nals) -> bool
+    {
+        for (uint8_t i=0; i<num; i++)
+        {
+            uint16_t length = 0;
+            br->U(16, length);
+            size_t offset = br->CurBits() / 8;
+            // Hint : the record comes from the container (MP4, MKV), length is checked against the record itself
+            if (br->Error() || offset > size || length > size - offset)
+            {
+                H26x_LOG_ERROR << "[H264] truncated avcC parameter set, length is " << length << ", but only " << (offset > size ? 0 : size - offset) << " bytes left" << H26x_LOG_TERMINATOR;
+                return false;
+            }
+            br->Skip(length * 8);
+            H264NalSyntax::ptr nal = MakeNalSyntax();
+            if (!DeserializeNalSyntax(data + offset, length, nal))
+            {
+                return false;
+            }
+            nals.push_back(nal);
+        }
+        return true;
+    };
+    // Hint : the record is not escaped, its NAL units are escaped on their own
+    H26xBinaryReader::ptr br = std::make_shared<H26xBinaryReader>(data, size, false);
+    MMP_H26X_TRY
+    {
+        br->U(8, record->configurationVersion);
+        br->U(8, record->AVCProfileIndication);
+        br->U(8, record->profile_compatibility);
+        br->U(8, record->AVCLevelIndication);
+        br->Skip(6); // reserved
+        br->U(2, record->lengthSizeMinusOne);
+        MPP_H26X_SYNTAXT_STRICT_CHECK(record->lengthSizeMinusOne != 2, "[avcC] lengthSizeMinusOne out of range", return false);
+        br->Skip(3); // reserved
+        br->U(5, record->numOfSequenceParameterSets);
+        if (!deserializeParameterSets(br, record->numOfSequenceParameterSets, record->sequenceParameterSetNALUnits))
+        {
+            return false;
+        }
+        br->U(8, record->numOfPictureParameterSets);
+        if (!deserializeParameterSets(br, record->numOfPictureParameterSets, record->pictureParameterSetNALUnits))
+        {
+            return false;
+        }
+        // Hint : the extension is absent from many records written before it was specified, only read it when present
+        if ((record->AVCProfileIndication == 100 || record->AVCProfileIndication == 110 ||
+             record->AVCProfileIndication == 122 || record->AVCProfileIndication == 144) &&
+            size * 8 >= br->CurBits() + 32)
+        {
+            br->Skip(6); // reserved
+            br->U(2, record->chroma_format);
+            br->Skip(5); // reserved
+            br->U(3, record->bit_depth_luma_minus8);
+            br->Skip(5); // reserved
+            br->U(3, record->bit_depth_chroma_minus8);
+            br->U(8, record->numOfSequenceParameterSetExt);
+            if (!deserializeParameterSets(br, record->numOfSequenceParameterSetExt, record->sequenceParameterSetExtNALUnits))
+            {
+                return false;
+            }
+        }
+        return !br->Error();
+    }
+    MMP_H26X_CATCH(...)
+    {
+        return false;
+    }
+    return false;
+}
+
+bool H264Deserialize::DeserializeLengthPrefixedNalUnits(const uint8_t* data, size_t size, uint8_t lengthSize, std::vector<H264NalSyntax::ptr>& nals)
+{
+    if (lengthSize != 1 && lengthSize != 2 && lengthSize != 4)
+    {
+        H26x_LOG_ERROR << "[H264] unsupport length size " << (uint32_t)lengthSize << H26x_LOG_TERMINATOR;
+        return false;
+    }
+    size_t pos = 0;
+    while (pos < size)
+    {
+        if (size - pos < lengthSize)
+        {
+            H26x_LOG_ERROR << "[H264] truncated length prefix" << H26x_LOG_TERMINATOR;
+            return false;
+        }
+        size_t length = 0;
+        for (uint8_t i=0; i<lengthSize; i++)
+        {
+            length = (length << 8) | data[pos + i];
+        }
+        pos += lengthSize;
+        if (size - pos < length)
+        {
+            H26x_LOG_ERROR << "[H264] truncated NAL unit, length is " << length << ", but only " << size - pos << " bytes left" << H26x_LOG_TERMINATOR;
+            return false;
+        }
+        if (length && !NalUnitTypeEnabled(data[pos] & 0x1F))
+        {
+            pos += length;
+            continue;
+        }
+        H264NalSyntax::ptr nal = MakeNalSyntax();
+        bool res = DeserializeNalSyntax(data + pos, length, nal);
+        nals.push_back(nal);
+        if (!res)
+        {
+            return false;
+        }
+        pos += length;
+    }
+    return true;
+}
+
 bool H264Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal)
 {
     // See also : ISO 14496/10(2020) - B.1.1 Byte stream NAL unit syntax
-    try
+    MMP_H26X_TRY
     {
         uint32_t next_24_bits = 0;
-        br->U(24, next_24_bits, true);
+        next_24_bits = br->ShowBits(24);
         while (next_24_bits != 0x000001)
         {
+            if (br->Error()) // eof (MMP_H26X_NO_EXCEPTIONS)
+            {
+                return true;
+            }
             if ((next_24_bits & 0xFFFF) == 0)
             {
-                br->Skip(8);
+                br->SkipBits(8);
             }
             else if ((next_24_bits & 0xFF) == 0)
             {
-                br->Skip(16);
+                br->SkipBits(16);
             }
             else
             {
-                br->Skip(32);
+                br->SkipBits(24); // Hint : the next start code may begin right after the third byte
             }
-            br->U(24, next_24_bits, true);
+            next_24_bits = br->ShowBits(24);
         }
-        br->Skip(24); // start_code_prefix_one_3bytes /* equal to 0x000001 */
+        br->SkipBits(24); // start_code_prefix_one_3bytes /* equal to 0x000001 */
         if (!DeserializeNalSyntax(br, nal))
         {
             return false;
         }
         while (br->more_data_in_byte_stream())
         {
-            br->U(24, next_24_bits, true);
+            next_24_bits = br->ShowBits(24);
             if (next_24_bits != 0x000001)
             {
                 if ((next_24_bits & 0xFFFF) == 0)
                 {
-                    br->Skip(8);
+                    br->SkipBits(8);
                 }
                 else if ((next_24_bits & 0xFF) == 0)
                 {
-                    br->Skip(16);
+                    br->SkipBits(16);
                 }
                 else
                 {
-                    br->Skip(32);
+                    br->SkipBits(24); // Hint : the next start code may begin right after the third byte
                 }
             }
             else
@@ -94,11 +501,11 @@ bool H264Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H26
         }
         return true;
     }
-    catch (const std::out_of_range& /* eof */)
+    MMP_H26X_CATCH(const std::out_of_range& /* eof */)
     {
         return true;
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -107,7 +514,7 @@ bool H264Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H26
 bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal)
 {
     // See also : ISO 14496/10(2020) - 7.3.1 NAL unit syntax
-    try
+    MMP_H26X_TRY
     {
         uint8_t  forbidden_zero_bit = 0;
         br->BeginNalUnit();
@@ -115,6 +522,11 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
         MPP_H26X_SYNTAXT_STRICT_CHECK(forbidden_zero_bit == 0, "[nal] forbidden_zero_bit should be 0", return false);
         br->U(2, nal->nal_ref_idc);
         br->U(5, nal->nal_unit_type);
+        if (!NalUnitTypeEnabled(nal->nal_unit_type))
+        {
+            br->EndNalUnit();
+            return !br->Error();
+        }
         if (nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_PREFIX || nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SLC_EXT ||
             nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_VDRD
         )
@@ -129,7 +541,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             }
             if (nal->svc_extension_flag)
             {
-                nal->svc = std::make_shared<H264NalSvcSyntax>();
+                nal->svc = MakeSyntax<H264NalSvcSyntax>();
                 if (!DeserializeNalSvcSyntax(br, nal->svc))
                 {
                     return false;
@@ -137,7 +549,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             }
             else if (nal->avc_3d_extension_flag)
             {
-                nal->avc = std::make_shared<H264Nal3dAvcSyntax>();
+                nal->avc = MakeSyntax<H264Nal3dAvcSyntax>();
                 if (!DeserializeNal3dAvcSyntax(br, nal->avc))
                 {
                     return false;
@@ -145,7 +557,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             }
             else
             {
-                nal->mvc = std::make_shared<H264NalMvcSyntax>();
+                nal->mvc = MakeSyntax<H264NalMvcSyntax>();
                 if (!DeserializeNalMvcSyntax(br, nal->mvc))
                 {
                     return false;
@@ -179,7 +591,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             {
                 // Hint : Slice = Slice header + Slice data + rbsp_trailing_bits()
                 //        only parse slice header and may move to next nal unit
-                nal->slice = std::make_shared<H264SliceHeaderSyntax>();
+                nal->slice = MakeSyntax<H264SliceHeaderSyntax>();
                 if (!DeserializeSliceHeaderSyntax(br, nal, nal->slice))
                 {
                     assert(false);
@@ -190,7 +602,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             }
             case H264NaluType::MMP_H264_NALU_TYPE_SEI:
             {
-                nal->sei = std::make_shared<H264SeiSyntax>();
+                nal->sei = MakeSyntax<H264SeiSyntax>();
                 if (!DeserializeSeiSyntax(br, nal->sei))
                 {
                     assert(false);
@@ -204,18 +616,56 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
                 break;
         }
         br->EndNalUnit();
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
 }
 
+bool H264Deserialize::DeserializeNalSyntax(const uint8_t* data, size_t size, H264NalSyntax::ptr nal)
+{
+    // Hint : parameter sets are repeated before every IDR picture by most broadcast sources,
+    //        byte identical ones are looked up by hash instead of deserialized again
+    uint8_t nal_unit_type = size ? data[0] & 0x1F : H264NaluType::MMP_H264_NALU_TYPE_NULL;
+    bool isParameterSet = (nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SPS || nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_PPS) && NalUnitTypeEnabled(nal_unit_type);
+    uint64_t hash = 0;
+    if (isParameterSet)
+    {
+        hash = H26xHash(data, size);
+        if (ReuseParameterSet(data, size, hash, nal))
+        {
+            return true;
+        }
+        // Hint : then among parameter sets deserialized by other streams, see also SetParameterSetStore()
+        if (_parameterSetStore && FindParameterSet(data, size, hash, nal))
+        {
+            return true;
+        }
+    }
+    // Hint : one reader is kept and rebound for every NAL unit, no per-byte indirection and no stream seeking
+    if (!_spanReader)
+    {
+        _spanReader = std::make_shared<H26xBinaryReader>(data, size);
+    }
+    else
+    {
+        _spanReader->Reset(data, size);
+    }
+    _spanReader->SetNalUnitSize(size);
+    bool res = DeserializeNalSyntax(_spanReader, nal);
+    if (res && isParameterSet)
+    {
+        InternParameterSet(data, size, hash, nal);
+    }
+    return res;
+}
+
 bool H264Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, H264HrdSyntax::ptr hrd)
 {
     // See also : ISO 14496/10(2020) - E.1.2 HRD parameters syntax
-    try
+    MMP_H26X_TRY
     {
         br->UE(hrd->cpb_cnt_minus1);
         {
@@ -241,9 +691,9 @@ bool H264Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, H264HrdSynt
         br->U(5, hrd->cpb_removal_delay_length_minus1);
         br->U(5, hrd->dpb_output_delay_length_minus1);
         br->U(5, hrd->time_offset_length);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -290,7 +740,7 @@ bool H264Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H264VuiSynt
     };
 
     // See also : ISO 14496/10(2020) - E.1.1 VUI parameters syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, vui->aspect_ratio_info_present_flag);
         if (vui->aspect_ratio_info_present_flag)
@@ -382,9 +832,9 @@ bool H264Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H264VuiSynt
             br->UE(vui->num_reorder_frames);
             br->UE(vui->max_dec_frame_buffering);
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -393,7 +843,7 @@ bool H264Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H264VuiSynt
 bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSyntax::ptr sei)
 {
     // See also : ISO 14496/10(2020) - 7.3.2.3.1 Supplemental enhancement information message syntax
-    try
+    MMP_H26X_TRY
     {
         uint8_t ff_byte = 0;
         do
@@ -408,12 +858,17 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             sei->payloadSize += ff_byte;
         } while (ff_byte == 0xFF);
 
+        if (sei->payloadType < 256 && !_seiPayloadTypeMask.test(sei->payloadType))
+        {
+            br->Skip(sei->payloadSize * 8);
+            return !br->Error();
+        }
         switch (sei->payloadType) 
         {
             // See also : ISO 14496/10(2020) - D.1.1 General SEI message syntax
             case H264SeiType::MMP_H264_SEI_BUFFERING_PERIOD:
             {
-                sei->bp = std::make_shared<H264SeiBufferPeriodSyntax>();
+                sei->bp = MakeSyntax<H264SeiBufferPeriodSyntax>();
                 if (!DeserializeSeiBufferPeriodSyntax(br, sei->bp))
                 {
                     return false;
@@ -423,7 +878,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             case H264SeiType::MMP_H264_SEI_PIC_TIMING:
             {
                 H264VuiSyntax::ptr vui = _contex->sps && _contex->sps->vui_parameters_present_flag ? _contex->sps->vui_seq_parameters : nullptr;
-                sei->pt = std::make_shared<H264SeiPictureTimingSyntax>();
+                sei->pt = MakeSyntax<H264SeiPictureTimingSyntax>();
                 MPP_H26X_SYNTAXT_STRICT_CHECK(vui, "[sei] missing vui", return false);
                 if (!DeserializeSeiPictureTimingSyntax(br, vui, sei->pt))
                 {
@@ -433,7 +888,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MMP_H264_SEI_USER_DATA_REGISTERED_ITU_T_T35:
             {
-                sei->udr = std::make_shared<H264SeiUserDataRegisteredSyntax>();
+                sei->udr = MakeSyntax<H264SeiUserDataRegisteredSyntax>();
                 if (!DeserializeSeiUserDataRegisteredSyntax(br, sei->payloadSize, sei->udr))
                 {
                     return false;
@@ -442,7 +897,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MMP_H264_SEI_USER_DATA_UNREGISTERED:
             {
-                sei->udn = std::make_shared<H264SeiUserDataUnregisteredSyntax>();
+                sei->udn = MakeSyntax<H264SeiUserDataUnregisteredSyntax>();
                 if (!DeserializeSeiUserDataUnregisteredSyntax(br, sei->payloadSize, sei->udn))
                 {
                     return false;
@@ -451,7 +906,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MMP_H264_SEI_RECOVERY_POINT:
             {
-                sei->rp = std::make_shared<H264SeiRecoveryPointSyntax>();
+                sei->rp = MakeSyntax<H264SeiRecoveryPointSyntax>();
                 if (!DeserializeSeiRecoveryPointSyntax(br, sei->rp))
                 {
                     return false;
@@ -460,7 +915,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MMP_H264_SEI_CONTENT_LIGHT_LEVEL_INFO:
             {
-                sei->clli = std::make_shared<H264SeiContentLigntLevelInfoSyntax>();
+                sei->clli = MakeSyntax<H264SeiContentLigntLevelInfoSyntax>();
                 if (!DeserializeSeiContentLigntLevelInfoSyntax(br, sei->clli))
                 {
                     return false;
@@ -469,7 +924,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MMP_H264_SEI_DISPLAY_ORIENTATION:
             {
-                sei->dot = std::make_shared<H264SeiDisplayOrientationSyntax>();
+                sei->dot = MakeSyntax<H264SeiDisplayOrientationSyntax>();
                 if (!DeserializeSeiDisplayOrientationSyntax(br, sei->dot))
                 {
                     return false;
@@ -478,7 +933,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MMP_H264_SEI_FILM_GRAIN_CHARACTERISTICS:
             {
-                sei->fg = std::make_shared<H264SeiFilmGrainSyntax>();
+                sei->fg = MakeSyntax<H264SeiFilmGrainSyntax>();
                 if (!DeserializeSeiFilmGrainSyntax(br, sei->fg))
                 {
                     return false;
@@ -487,7 +942,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MMP_H264_SEI_FRAME_PACKING_ARRANGEMENT:
             {
-                sei->fpa = std::make_shared<H264SeiFramePackingArrangementSyntax>();
+                sei->fpa = MakeSyntax<H264SeiFramePackingArrangementSyntax>();
                 if (!DeserializeSeiFramePackingArrangementSyntax(br, sei->fpa))
                 {
                     return false;
@@ -496,7 +951,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MMP_H264_SEI_ALTERNATIVE_TRANSFER_CHARACTERISTICS:
             {
-                sei->atc = std::make_shared<H264SeiAlternativeTransferCharacteristicsSyntax>();
+                sei->atc = MakeSyntax<H264SeiAlternativeTransferCharacteristicsSyntax>();
                 if (!DeserializeSeiAlternativeTransferCharacteristicsSyntax(br, sei->atc))
                 {
                     return false;
@@ -505,7 +960,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MP_H264_SEI_AMBIENT_VIEWING_ENVIRONMENT:
             {
-                sei->awe = std::make_shared<H264AmbientViewingEnvironmentSyntax>();
+                sei->awe = MakeSyntax<H264AmbientViewingEnvironmentSyntax>();
                 if (!DeserializeAmbientViewingEnvironmentSyntax(br, sei->awe))
                 {
                     return false;
@@ -514,7 +969,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
             }
             case H264SeiType::MMP_H264_SEI_MASTERING_DISPLAY_COLOUR_VOLUME:
             {
-                sei->mpvc = std::make_shared<H264MasteringDisplayColourVolumeSyntax>();
+                sei->mpvc = MakeSyntax<H264MasteringDisplayColourVolumeSyntax>();
                 if (!DeserializeSeiMasteringDisplayColourVolumeSyntax(br, sei->mpvc))
                 {
                     return false;
@@ -525,9 +980,9 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
                 br->Skip(sei->payloadSize * 8);
                 break;
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -536,7 +991,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
 bool H264Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps)
 {
     // See also : ISO 14496/10(2020) - 7.3.2.1.1 Sequence parameter set data syntax
-    try
+    MMP_H26X_TRY
     {
         uint8_t reserved_zero_2bits = 0;
         br->U(8, sps->profile_idc);
@@ -570,11 +1025,6 @@ bool H264Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H264SpsSynt
             if (sps->seq_scaling_matrix_present_flag)
             {
                 int32_t loopTime = (sps->chroma_format_idc != H264ChromaFormat::MMP_H264_CHROMA_444) ? 8 : 12;
-                sps->seq_scaling_list_present_flag.resize(loopTime);
-                sps->ScalingList4x4.resize(6);
-                sps->UseDefaultScalingMatrix4x4Flag.resize(6);
-                sps->ScalingList8x8.resize(loopTime - 6);
-                sps->UseDefaultScalingMatrix8x8Flag.resize(loopTime - 6);
                 for (int32_t i=0; i<loopTime; i++)
                 {
                     br->U(1, sps->seq_scaling_list_present_flag[i]);
@@ -582,14 +1032,14 @@ bool H264Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H264SpsSynt
                     {
                         if (i < 6)
                         {
-                            if (!DeserializeScalingListSyntax(br, sps->ScalingList4x4[i], 16, sps->UseDefaultScalingMatrix4x4Flag[i]))
+                            if (!DeserializeScalingListSyntax(br, sps->ScalingList4x4[i].data(), 16, sps->UseDefaultScalingMatrix4x4Flag[i]))
                             {
                                 return false;
                             }
                         }
                         else
                         {
-                            if (!DeserializeScalingListSyntax(br, sps->ScalingList8x8[i - 6], 64, sps->UseDefaultScalingMatrix8x8Flag[i]))
+                            if (!DeserializeScalingListSyntax(br, sps->ScalingList8x8[i - 6].data(), 64, sps->UseDefaultScalingMatrix8x8Flag[i - 6]))
                             {
                                 return false;
                             }
@@ -663,11 +1113,10 @@ bool H264Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H264SpsSynt
             }
         }
         br->rbsp_trailing_bits();
-        _contex->spsSet[sps->seq_parameter_set_id] = sps;
-        _contex->sps = sps;
-        return true;
+        StoreSps(sps);
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -676,7 +1125,7 @@ bool H264Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H264SpsSynt
 bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal, H264SliceHeaderSyntax::ptr slice)
 {
     // See aslo : ISO 14496/10(2020) - 7.3.3 Slice header syntax
-    try
+    MMP_H26X_TRY
     {
         size_t begin = br->CurBits();
         H264PpsSyntax::ptr pps = nullptr;
@@ -688,10 +1137,13 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
         slice->slice_type = slice->slice_type % 5; // See aslo : ISO 14496/10(2020) - Table 7-6 – Name association to slice_type 
         MPP_H26X_SYNTAXT_STRICT_CHECK(!(IdrPicFlag && slice->slice_type != H264SliceType::MMP_H264_I_SLICE), "[slice] A non-intra slice in an IDR NAL unit.", return false);
         br->UE(slice->pic_parameter_set_id);
-        MPP_H26X_SYNTAXT_STRICT_CHECK(_contex->ppsSet.count(slice->pic_parameter_set_id), "[slice] missing pps", return false);
-        pps = _contex->ppsSet[slice->pic_parameter_set_id];
-        MPP_H26X_SYNTAXT_STRICT_CHECK(_contex->ppsSet.count(pps->seq_parameter_set_id), "[slice] missing sps", return false);
-        sps = _contex->spsSet[pps->seq_parameter_set_id];
+        // Hint : lookups only, the context may be shared by lazy NAL units deserialized concurrently
+        auto ppsIt = _contex->ppsSet.find(slice->pic_parameter_set_id);
+        MPP_H26X_SYNTAXT_STRICT_CHECK(ppsIt != _contex->ppsSet.end(), "[slice] missing pps", return false);
+        pps = ppsIt->second;
+        auto spsIt = _contex->spsSet.find(pps->seq_parameter_set_id);
+        MPP_H26X_SYNTAXT_STRICT_CHECK(spsIt != _contex->spsSet.end(), "[slice] missing sps", return false);
+        sps = spsIt->second;
         if (sps->separate_colour_plane_flag == 1)
         {
             br->U(2, slice->colour_plane_id);
@@ -761,7 +1213,7 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
         }
         else
         {
-            slice->rplm = std::make_shared<H264ReferencePictureListModificationSyntax>();
+            slice->rplm = MakeSyntax<H264ReferencePictureListModificationSyntax>();
             if (!DeserializeReferencePictureListModificationSyntax(br, slice, slice->rplm))
             {
                 return false;
@@ -771,7 +1223,7 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
             (pps->weighted_bipred_idc == 1 && slice->slice_type == H264SliceType::MMP_H264_B_SLICE)
         )
         {
-            slice->pwt = std::make_shared<H264PredictionWeightTableSyntax>();
+            slice->pwt = MakeSyntax<H264PredictionWeightTableSyntax>();
             if (!DeserializePredictionWeightTableSyntax(br, sps, slice, slice->pwt))
             {
                 return false;
@@ -779,7 +1231,7 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
         }
         if (nal->nal_ref_idc != 0)
         {
-            slice->drpm = std::make_shared<H264DecodedReferencePictureMarkingSyntax>();
+            slice->drpm = MakeSyntax<H264DecodedReferencePictureMarkingSyntax>();
             if (!DeserializeDecodedReferencePictureMarkingSyntax(br, nal, slice->drpm))
             {
                 return false;
@@ -819,9 +1271,9 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
             br->U(2, slice->slice_group_change_cycle);
         }
         slice->slice_data_bit_offset = br->CurBits() - begin;
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -830,7 +1282,7 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
 bool H264Deserialize::DeserializeDecodedReferencePictureMarkingSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal, H264DecodedReferencePictureMarkingSyntax::ptr drpm)
 {
     // See also : ISO 14496/10(2020) - 7.3.3.3 Decoded reference picture marking syntax
-    try
+    MMP_H26X_TRY
     {
         bool IdrPicFlag = nal->nal_unit_type == 5 /* MMP_H264_NALU_TYPE_IDR */ ? true : false;
         if (IdrPicFlag)
@@ -880,9 +1332,9 @@ bool H264Deserialize::DeserializeDecodedReferencePictureMarkingSyntax(H26xBinary
                 } while (memory_management_control_operation != 0);
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -891,7 +1343,7 @@ bool H264Deserialize::DeserializeDecodedReferencePictureMarkingSyntax(H26xBinary
 bool H264Deserialize::DeserializeSubSpsSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps, H264SubSpsSyntax::ptr subSps)
 {
     // See also : ISO 14496/10(2020) - 7.3.2.1.3 Subset sequence parameter set RBSP syntax
-    try
+    MMP_H26X_TRY
     {
         if (!DeserializeSpsSyntax(br, sps))
         {
@@ -943,9 +1395,9 @@ bool H264Deserialize::DeserializeSubSpsSyntax(H26xBinaryReader::ptr br, H264SpsS
         }
         br->U(1, subSps->additional_extension2_flag);
         // TODO
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -954,7 +1406,7 @@ bool H264Deserialize::DeserializeSubSpsSyntax(H26xBinaryReader::ptr br, H264SpsS
 bool H264Deserialize::DeserializeSpsMvcSyntax(H26xBinaryReader::ptr br, H264SpsMvcSyntax::ptr mvc)
 {
     // See also : ISO 14496/10(2020) - G.3.3.2.1.4 Sequence parameter set MVC extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->UE(mvc->num_views_minus1);
         mvc->view_id.resize(mvc->num_views_minus1 + 1);
@@ -1027,9 +1479,9 @@ bool H264Deserialize::DeserializeSpsMvcSyntax(H26xBinaryReader::ptr br, H264SpsM
                 br->UE(mvc->applicable_op_num_views_minus1[i][j]);
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1039,7 +1491,7 @@ bool H264Deserialize::DeserializeSpsMvcSyntax(H26xBinaryReader::ptr br, H264SpsM
 bool H264Deserialize::DeserializeMvcVuiSyntax(H26xBinaryReader::ptr br, H264MvcVuiSyntax::ptr mvcVui)
 {
     // See also : ISO 14496/10(2020) - G.10.1 MVC VUI parameters extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->UE(mvcVui->vui_mvc_num_ops_minus1);
         mvcVui->vui_mvc_temporal_id.resize(mvcVui->vui_mvc_num_ops_minus1 + 1);
@@ -1097,9 +1549,9 @@ bool H264Deserialize::DeserializeMvcVuiSyntax(H26xBinaryReader::ptr br, H264MvcV
             }
             br->U(1, mvcVui->vui_mvc_pic_struct_present_flag[i]);
         }
-        return true;
+        return !br->Error();
     }
-    catch(const std::exception& e)
+    MMP_H26X_CATCH(const std::exception& e)
     {
         return false;
     }
@@ -1108,7 +1560,7 @@ bool H264Deserialize::DeserializeMvcVuiSyntax(H26xBinaryReader::ptr br, H264MvcV
 bool H264Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H264PpsSyntax::ptr pps)
 {
     // See aslo : ISO 14496/10(2020) - 7.3.2.2 Picture parameter set RBSP syntax
-    try
+    MMP_H26X_TRY
     {
         br->more_rbsp_data();
         br->UE(pps->pic_parameter_set_id);
@@ -1165,12 +1617,7 @@ bool H264Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H264PpsSynt
             br->U(1, pps->pic_scaling_matrix_present_flag);
             if (pps->pic_scaling_matrix_present_flag)
             {
-                int32_t loopTime = ((sps->chroma_format_idc != H264ChromaFormat::MMP_H264_CHROMA_444) ? 2 : 6) * pps->transform_8x8_mode_flag;
-                pps->pic_scaling_list_present_flag.resize(loopTime);
-                pps->ScalingList4x4.resize(6);
-                pps->UseDefaultScalingMatrix4x4Flag.resize(6);
-                pps->ScalingList8x8.resize(loopTime - 6);
-                pps->UseDefaultScalingMatrix8x8Flag.resize(loopTime - 6);
+                int32_t loopTime = 6 + ((sps->chroma_format_idc != H264ChromaFormat::MMP_H264_CHROMA_444) ? 2 : 6) * pps->transform_8x8_mode_flag;
                 for (int32_t i=0; i<loopTime; i++)
                 {
                     br->U(1, pps->pic_scaling_list_present_flag[i]);
@@ -1178,67 +1625,53 @@ bool H264Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H264PpsSynt
                     {
                         if (i < 6)
                         {
-                            if (!DeserializeScalingListSyntax(br, pps->ScalingList4x4[i], 16, pps->UseDefaultScalingMatrix4x4Flag[i]))
+                            if (!DeserializeScalingListSyntax(br, pps->ScalingList4x4[i].data(), 16, pps->UseDefaultScalingMatrix4x4Flag[i]))
                             {
                                 return false;
                             }
                         }
                         else
                         {
-                            if (!DeserializeScalingListSyntax(br, pps->ScalingList8x8[i - 6], 64, pps->UseDefaultScalingMatrix8x8Flag[i]))
+                            if (!DeserializeScalingListSyntax(br, pps->ScalingList8x8[i - 6].data(), 64, pps->UseDefaultScalingMatrix8x8Flag[i - 6]))
                             {
                                 return false;
                             }
                         }
                     }
                 }
-                br->SE(pps->second_chroma_qp_index_offset);
-                {
-                    // Hint : second_chroma_qp_index_offset specifies the offset that shall be added to QPY and QSY for addressing the table of 
-                    // QPC values for the Cr chroma component. The value of second_chroma_qp_index_offset shall be in the range of −12 to 
-                    // +12, inclusive.
-                    MPP_H26X_SYNTAXT_STRICT_CHECK(pps->second_chroma_qp_index_offset >= -12 && pps->second_chroma_qp_index_offset <= 12, "[sps] second_chroma_qp_index_offset out of range", return false);
-                }
             }
-            else
+            br->SE(pps->second_chroma_qp_index_offset);
             {
-                // Reference : FFmpeg 6.x
-                pps->second_chroma_qp_index_offset = pps->chroma_qp_index_offset;
+                // Hint : second_chroma_qp_index_offset specifies the offset that shall be added to QPY and QSY for addressing the table of 
+                // QPC values for the Cr chroma component. The value of second_chroma_qp_index_offset shall be in the range of −12 to 
+                // +12, inclusive.
+                MPP_H26X_SYNTAXT_STRICT_CHECK(pps->second_chroma_qp_index_offset >= -12 && pps->second_chroma_qp_index_offset <= 12, "[sps] second_chroma_qp_index_offset out of range", return false);
             }
         }
         else
         {
+            // Reference : FFmpeg 6.x
+            pps->second_chroma_qp_index_offset = pps->chroma_qp_index_offset;
             // (7-8)
             {
-                pps->ScalingList4x4.resize(6);
                 for (size_t i=0; i<6; i++)
                 {
-                    pps->ScalingList4x4[i].resize(16);
-                    for (size_t j=0; j<16; j++)
-                    {
-                        pps->ScalingList4x4[i][j] = 16;
-                    }
+                    pps->ScalingList4x4[i].fill(16);
                 }
             }
             // (7-9)
             {
-                pps->ScalingList8x8.resize(2);
-                for (size_t i=0; i<2; i++)
+                for (size_t i=0; i<6; i++)
                 {
-                    pps->ScalingList8x8[i].resize(64);
-                    for (size_t j=0; j<64; j++)
-                    {
-                        pps->ScalingList8x8[i][j] = 16;
-                    }
+                    pps->ScalingList8x8[i].fill(16);
                 }
             }
         }
         br->rbsp_trailing_bits();
-        _contex->ppsSet[pps->pic_parameter_set_id] = pps;
-        _contex->pps = pps;
-        return true;
+        StorePps(pps);
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1247,7 +1680,7 @@ bool H264Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H264PpsSynt
 bool H264Deserialize::DeserializeNalSvcSyntax(H26xBinaryReader::ptr br, H264NalSvcSyntax::ptr svc)
 {
     // See also : ISO 14496/10(2020) - F.3.3.1.1 NAL unit header SVC extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, svc->idr_flag);
         br->U(6, svc->priority_id);
@@ -1259,9 +1692,9 @@ bool H264Deserialize::DeserializeNalSvcSyntax(H26xBinaryReader::ptr br, H264NalS
         br->U(1, svc->discardable_flag);
         br->U(1, svc->output_flag);
         br->U(1, svc->reserved_three_2bits);
-        return true;
+        return !br->Error();
     }
-    catch(const std::exception& e)
+    MMP_H26X_CATCH(const std::exception& e)
     {
         return false;
     }
@@ -1270,7 +1703,7 @@ bool H264Deserialize::DeserializeNalSvcSyntax(H26xBinaryReader::ptr br, H264NalS
 bool H264Deserialize::DeserializeNal3dAvcSyntax(H26xBinaryReader::ptr br, H264Nal3dAvcSyntax::ptr avc)
 {
     // See also : ISO 14496/10(2020) - I.3.3.1.1 NAL unit header 3D-AVC extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(8, avc->view_idx);
         br->U(1, avc->depth_flag);
@@ -1278,9 +1711,9 @@ bool H264Deserialize::DeserializeNal3dAvcSyntax(H26xBinaryReader::ptr br, H264Na
         br->U(3, avc->temporal_id);
         br->U(1, avc->anchor_pic_flag);
         br->U(1, avc->inter_view_flag);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1289,7 +1722,7 @@ bool H264Deserialize::DeserializeNal3dAvcSyntax(H26xBinaryReader::ptr br, H264Na
 bool H264Deserialize::DeserializeNalMvcSyntax(H26xBinaryReader::ptr br, H264NalMvcSyntax::ptr mvc)
 {
     // See also : ISO 14496/10(2020) - I.3.3.1.1 NAL unit header 3D-AVC extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, mvc->non_idr_flag);
         br->U(6, mvc->priority_id);
@@ -1298,24 +1731,23 @@ bool H264Deserialize::DeserializeNalMvcSyntax(H26xBinaryReader::ptr br, H264NalM
         br->U(1, mvc->anchor_pic_flag);
         br->U(1, mvc->inter_view_flag);
         br->U(1, mvc->reserved_one_bit);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
     
 }
 
-bool H264Deserialize::DeserializeScalingListSyntax(H26xBinaryReader::ptr br, std::vector<int32_t>& scalingList, int32_t sizeOfScalingList, int32_t& useDefaultScalingMatrixFlag)
+bool H264Deserialize::DeserializeScalingListSyntax(H26xBinaryReader::ptr br, int32_t* scalingList, int32_t sizeOfScalingList, int32_t& useDefaultScalingMatrixFlag)
 {
     // See aslo : ISO 14496/10(2020) - 7.3.2.1.1.1 Scaling list syntax
-    try
+    MMP_H26X_TRY
     {
         int32_t lastScale = 8;
         int32_t nextScale = 8;
         int32_t delta_scale = 0;
-        scalingList.resize(sizeOfScalingList);
         for (int32_t j=0; j<sizeOfScalingList; j++)
         {
             if (nextScale != 0)
@@ -1327,9 +1759,9 @@ bool H264Deserialize::DeserializeScalingListSyntax(H26xBinaryReader::ptr br, std
             scalingList[j] = (nextScale == 0) ? lastScale : nextScale;
             lastScale = scalingList[j];
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1338,7 +1770,7 @@ bool H264Deserialize::DeserializeScalingListSyntax(H26xBinaryReader::ptr br, std
 bool H264Deserialize::DeserializeReferencePictureListModificationSyntax(H26xBinaryReader::ptr br, H264SliceHeaderSyntax::ptr slice, H264ReferencePictureListModificationSyntax::ptr rplm)
 {
     // See also : ISO 14496/10(2020) - 7.3.3.1 Reference picture list modification syntax
-    try
+    MMP_H26X_TRY
     {
         if (slice->slice_type != 2 /* MMP_H264_I_SLICE */ && slice->slice_type != 4 /* MMP_H264_SI_SLICE */)
         {
@@ -1364,7 +1796,7 @@ bool H264Deserialize::DeserializeReferencePictureListModificationSyntax(H26xBina
                         rplm->modification_of_pic_nums_idcs_datas.push_back(modification_of_pic_nums_idcs_data);
                     }
                     rplm->modification_of_pic_nums_idcs.push_back(modification_of_pic_nums_idc);
-                } while(modification_of_pic_nums_idc != 3);
+                } while(modification_of_pic_nums_idc != 3 && !br->Error());
             }
         }
         if (slice->slice_type == 1 /* MMP_H264_B_SLICE */)
@@ -1391,12 +1823,12 @@ bool H264Deserialize::DeserializeReferencePictureListModificationSyntax(H26xBina
                         rplm->modification_of_pic_nums_idcs_datas.push_back(modification_of_pic_nums_idcs_data);
                     }
                     rplm->modification_of_pic_nums_idcs.push_back(modification_of_pic_nums_idc);
-                } while(modification_of_pic_nums_idc != 3);
+                } while(modification_of_pic_nums_idc != 3 && !br->Error());
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1405,7 +1837,7 @@ bool H264Deserialize::DeserializeReferencePictureListModificationSyntax(H26xBina
 bool H264Deserialize::DeserializePredictionWeightTableSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps, H264SliceHeaderSyntax::ptr slice, H264PredictionWeightTableSyntax::ptr pwt)
 {
     // See also : ISO 14496/10(2020) - 7.3.3.2 Prediction weight table syntax
-    try
+    MMP_H26X_TRY
     {
         uint32_t ChromaArrayType = sps->separate_colour_plane_flag == 1 ? 0 : sps->chroma_format_idc;
         br->UE(pwt->luma_log2_weight_denom);
@@ -1423,12 +1855,8 @@ bool H264Deserialize::DeserializePredictionWeightTableSyntax(H26xBinaryReader::p
                 MPP_H26X_SYNTAXT_STRICT_CHECK(pwt->chroma_log2_weight_denom >= 0 && pwt->chroma_log2_weight_denom <= 7, "[pwt] chroma_log2_weight_denom out of range", return false);
             }
         }
-        pwt->luma_weight_l0_flag.resize(slice->num_ref_idx_l0_active_minus1 + 1);
-        pwt->luma_weight_l0.resize(slice->num_ref_idx_l0_active_minus1 + 1);
-        pwt->luma_offset_l0.resize(slice->num_ref_idx_l0_active_minus1 + 1);
-        pwt->chroma_weight_l0_flag.resize(slice->num_ref_idx_l0_active_minus1 + 1);
-        pwt->chroma_weight_l0.resize(slice->num_ref_idx_l0_active_minus1 + 1);
-        pwt->chroma_offset_l0.resize(slice->num_ref_idx_l0_active_minus1 + 1);
+        // Hint : num_ref_idx_l0_active_minus1 shall be in the range of 0 to 31, inclusive.
+        MPP_H26X_SYNTAXT_STRICT_CHECK(slice->num_ref_idx_l0_active_minus1 < pwt->luma_weight_l0_flag.size(), "[pwt] num_ref_idx_l0_active_minus1 out of range", return false);
         for (uint32_t i=0; i<=slice->num_ref_idx_l0_active_minus1; i++)
         {
             br->U(1, pwt->luma_weight_l0_flag[i]);
@@ -1442,8 +1870,6 @@ bool H264Deserialize::DeserializePredictionWeightTableSyntax(H26xBinaryReader::p
                 br->U(1, pwt->chroma_weight_l0_flag[i]);
                 if (pwt->chroma_weight_l0_flag[i])
                 {
-                    pwt->chroma_weight_l0[i].resize(2);
-                    pwt->chroma_offset_l0[i].resize(2);
                     for (size_t j=0; j<2; j++)
                     {
                         br->SE(pwt->chroma_weight_l0[i][j]);
@@ -1454,27 +1880,21 @@ bool H264Deserialize::DeserializePredictionWeightTableSyntax(H26xBinaryReader::p
         }
         if (slice->slice_type == 1 /* MMP_H264_B_SLICE */)
         {
-            pwt->luma_weight_l1_flag.resize(slice->num_ref_idx_l1_active_minus1 + 1);
-            pwt->luma_weight_l1.resize(slice->num_ref_idx_l1_active_minus1 + 1);
-            pwt->luma_offset_l1.resize(slice->num_ref_idx_l1_active_minus1 + 1);
-            pwt->chroma_weight_l1_flag.resize(slice->num_ref_idx_l1_active_minus1 + 1);
-            pwt->chroma_weight_l1.resize(slice->num_ref_idx_l1_active_minus1 + 1);
-            pwt->chroma_offset_l1.resize(slice->num_ref_idx_l1_active_minus1 + 1);
+            // Hint : num_ref_idx_l1_active_minus1 shall be in the range of 0 to 31, inclusive.
+            MPP_H26X_SYNTAXT_STRICT_CHECK(slice->num_ref_idx_l1_active_minus1 < pwt->luma_weight_l1_flag.size(), "[pwt] num_ref_idx_l1_active_minus1 out of range", return false);
             for (uint32_t i=0; i<=slice->num_ref_idx_l1_active_minus1; i++)
             {
                 br->U(1, pwt->luma_weight_l1_flag[i]);
                 if (pwt->luma_weight_l1_flag[i])
                 {
                     br->SE(pwt->luma_weight_l1[i]);
-                    br->SE(pwt->luma_weight_l1[i]);
+                    br->SE(pwt->luma_offset_l1[i]);
                 }
                 if (ChromaArrayType != 0)
                 {
                     br->U(1, pwt->chroma_weight_l1_flag[i]);
                     if (pwt->chroma_weight_l1_flag[i])
                     {
-                        pwt->chroma_weight_l1[i].resize(2);
-                        pwt->chroma_offset_l1[i].resize(2);
                         for (size_t j=0; j<2; j++)
                         {
                             br->SE(pwt->chroma_weight_l1[i][j]);
@@ -1484,9 +1904,9 @@ bool H264Deserialize::DeserializePredictionWeightTableSyntax(H26xBinaryReader::p
                 }
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1495,16 +1915,17 @@ bool H264Deserialize::DeserializePredictionWeightTableSyntax(H26xBinaryReader::p
 bool H264Deserialize::DeserializeSeiBufferPeriodSyntax(H26xBinaryReader::ptr br, H264SeiBufferPeriodSyntax::ptr bp)
 {
     // See also : ISO 14496/10(2020) - D.1.2 Buffering period SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         br->UE(bp->seq_parameter_set_id);
 
-        if (_contex->spsSet.count(bp->seq_parameter_set_id) == 0)
+        auto spsIt = _contex->spsSet.find(bp->seq_parameter_set_id);
+        if (spsIt == _contex->spsSet.end())
         {
             assert(false);
             return false;
         }
-        H264SpsSyntax::ptr sps = _contex->spsSet[bp->seq_parameter_set_id];
+        H264SpsSyntax::ptr sps = spsIt->second;
 
         // The variable NalHrdBpPresentFlag is derived as follows:
         // - If any of the following is true, the value of NalHrdBpPresentFlag shall be set equal to 1:
@@ -1552,9 +1973,9 @@ bool H264Deserialize::DeserializeSeiBufferPeriodSyntax(H26xBinaryReader::ptr br,
                 br->U(sps->vui_seq_parameters->vcl_hrd_parameters->initial_cpb_removal_delay_length_minus1 + 1, bp->initial_cpb_removal_delay_offset[SchedSelIdx]);
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1563,7 +1984,7 @@ bool H264Deserialize::DeserializeSeiBufferPeriodSyntax(H26xBinaryReader::ptr br,
 bool H264Deserialize::DeserializeSeiUserDataRegisteredSyntax(H26xBinaryReader::ptr br, uint32_t payloadSize, H264SeiUserDataRegisteredSyntax::ptr udr)
 {
     // See also : ISO 14496/10(2020) - D.1.6 User data registered by ITU-T Rec. T.35 SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         uint32_t i = 0;
         br->U(8, udr->itu_t_t35_country_code);
@@ -1584,9 +2005,9 @@ bool H264Deserialize::DeserializeSeiUserDataRegisteredSyntax(H26xBinaryReader::p
             index++;
             i++;
         } while (i<payloadSize);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1595,7 +2016,7 @@ bool H264Deserialize::DeserializeSeiUserDataRegisteredSyntax(H26xBinaryReader::p
 bool H264Deserialize::DeserializeSeiUserDataUnregisteredSyntax(H26xBinaryReader::ptr br, uint32_t payloadSize, H264SeiUserDataUnregisteredSyntax::ptr udn)
 {
     // See also : ISO 14496/10(2020) - D.1.7 User data unregistered SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         for (size_t i=0; i<16; i++)
         {
@@ -1606,9 +2027,9 @@ bool H264Deserialize::DeserializeSeiUserDataUnregisteredSyntax(H26xBinaryReader:
         {
             br->U(8, udn->user_data_payload_byte[i-16]);
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1617,7 +2038,7 @@ bool H264Deserialize::DeserializeSeiUserDataUnregisteredSyntax(H26xBinaryReader:
 bool H264Deserialize::DeserializeSeiPictureTimingSyntax(H26xBinaryReader::ptr br, H264VuiSyntax::ptr vui, H264SeiPictureTimingSyntax::ptr pt)
 {
     // See also : ISO 14496/10(2020) - D.1.2 Buffering period SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         // The variable CpbDpbDelaysPresentFlag is derived as follows:
         //     – If any of the following is true, the value of CpbDpbDelaysPresentFlag shall be set equal to 1:
@@ -1659,26 +2080,11 @@ bool H264Deserialize::DeserializeSeiPictureTimingSyntax(H26xBinaryReader::ptr br
             // Hint : NumClockTS is determined by pic_struct as specified in Table D-1.
             int8_t NumClockTS[9] = {1, 1, 1, 2, 2, 3, 3, 2, 3};
             br->U(4, pt->pic_struct);
-            if (pt->pic_struct > 9)
+            if (pt->pic_struct > 8)
             {
                 assert(false);
                 return false;
             }
-            pt->clock_timestamp_flag.resize(NumClockTS[pt->pic_struct]);
-            pt->ct_type.resize(NumClockTS[pt->pic_struct]);
-            pt->nuit_field_based_flag.resize(NumClockTS[pt->pic_struct]);
-            pt->counting_type.resize(NumClockTS[pt->pic_struct]);
-            pt->full_timestamp_flag.resize(NumClockTS[pt->pic_struct]);
-            pt->discontinuity_flag.resize(NumClockTS[pt->pic_struct]);
-            pt->cnt_dropped_flag.resize(NumClockTS[pt->pic_struct]);
-            pt->n_frames.resize(NumClockTS[pt->pic_struct]);
-            pt->seconds_value.resize(NumClockTS[pt->pic_struct]);
-            pt->minutes_value.resize(NumClockTS[pt->pic_struct]);
-            pt->hours_value.resize(NumClockTS[pt->pic_struct]);
-            pt->seconds_flag.resize(NumClockTS[pt->pic_struct]);
-            pt->minutes_flag.resize(NumClockTS[pt->pic_struct]);
-            pt->hours_flag.resize(NumClockTS[pt->pic_struct]);
-            pt->time_offset.resize(NumClockTS[pt->pic_struct]);
             for (int8_t i=0; i<NumClockTS[pt->pic_struct]; i++)
             {
                 br->U(1, pt->clock_timestamp_flag[i]);
@@ -1738,9 +2144,9 @@ bool H264Deserialize::DeserializeSeiPictureTimingSyntax(H26xBinaryReader::ptr br
             }
         }
 
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1749,15 +2155,15 @@ bool H264Deserialize::DeserializeSeiPictureTimingSyntax(H26xBinaryReader::ptr br
 bool H264Deserialize::DeserializeSeiRecoveryPointSyntax(H26xBinaryReader::ptr br, H264SeiRecoveryPointSyntax::ptr pt)
 {
     // See also : ISO 14496/10(2020) - D.1.8 Recovery point SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         br->UE(pt->recovery_frame_cnt);
         br->U(1, pt->exact_match_flag);
         br->U(1, pt->broken_link_flag);
         br->U(2, pt->changing_slice_group_idc);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1766,13 +2172,13 @@ bool H264Deserialize::DeserializeSeiRecoveryPointSyntax(H26xBinaryReader::ptr br
 bool H264Deserialize::DeserializeSeiContentLigntLevelInfoSyntax(H26xBinaryReader::ptr br, H264SeiContentLigntLevelInfoSyntax::ptr clli)
 {
     // See also : ISO 14496/10(2020) - D.1.31 Content light level information SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(16, clli->max_content_light_level);
         br->U(16, clli->max_pic_average_light_level);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1781,7 +2187,7 @@ bool H264Deserialize::DeserializeSeiContentLigntLevelInfoSyntax(H26xBinaryReader
 bool H264Deserialize::DeserializeSeiDisplayOrientationSyntax(H26xBinaryReader::ptr br, H264SeiDisplayOrientationSyntax::ptr dot)
 {
     // See also : ISO 14496/10(2020) - D.1.27 Display orientation SEI message syntax
-    try 
+    MMP_H26X_TRY
     {
         br->U(1, dot->display_orientation_cancel_flag);
         if (dot->display_orientation_cancel_flag)
@@ -1792,9 +2198,9 @@ bool H264Deserialize::DeserializeSeiDisplayOrientationSyntax(H26xBinaryReader::p
             br->UE(dot->display_orientation_repetition_period);
             br->U(1, dot->display_orientation_extension_flag);
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1803,7 +2209,7 @@ bool H264Deserialize::DeserializeSeiDisplayOrientationSyntax(H26xBinaryReader::p
 bool H264Deserialize::DeserializeSeiMasteringDisplayColourVolumeSyntax(H26xBinaryReader::ptr br, H264MasteringDisplayColourVolumeSyntax::ptr mdcv)
 {
     // See also : ISO 14496/10(2020) - D.1.29 Mastering display colour volume SEI message syntax
-    try 
+    MMP_H26X_TRY
     {
         for (size_t c=0; c<3; c++)
         {
@@ -1814,9 +2220,9 @@ bool H264Deserialize::DeserializeSeiMasteringDisplayColourVolumeSyntax(H26xBinar
         br->U(16, mdcv->white_point_y);
         br->U(32, mdcv->max_display_mastering_luminance);
         br->U(32, mdcv->min_display_mastering_luminance);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1825,7 +2231,7 @@ bool H264Deserialize::DeserializeSeiMasteringDisplayColourVolumeSyntax(H26xBinar
 bool H264Deserialize::DeserializeSeiFilmGrainSyntax(H26xBinaryReader::ptr br, H264SeiFilmGrainSyntax::ptr fg)
 {
     // See also : ISO 14496/10(2020) - D.1.21 Film grain characteristics SEI message syntax
-    try 
+    MMP_H26X_TRY
     {
         br->U(1, fg->film_grain_characteristics_cancel_flag);
         if (!fg->film_grain_characteristics_cancel_flag)
@@ -1873,9 +2279,9 @@ bool H264Deserialize::DeserializeSeiFilmGrainSyntax(H26xBinaryReader::ptr br, H2
             }
             br->UE(fg->film_grain_characteristics_repetition_period);
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1884,7 +2290,7 @@ bool H264Deserialize::DeserializeSeiFilmGrainSyntax(H26xBinaryReader::ptr br, H2
 bool H264Deserialize::DeserializeSeiFramePackingArrangementSyntax(H26xBinaryReader::ptr br, H264SeiFramePackingArrangementSyntax::ptr fpa)
 {
     // See also : ISO 14496/10(2020) - D.1.27 Display orientation SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         br->UE(fpa->frame_packing_arrangement_id);
         br->U(1, fpa->frame_packing_arrangement_cancel_flag);
@@ -1910,9 +2316,9 @@ bool H264Deserialize::DeserializeSeiFramePackingArrangementSyntax(H26xBinaryRead
             br->UE(fpa->frame_packing_arrangement_repetition_period);
         }
         br->U(1, fpa->frame_packing_arrangement_extension_flag);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1921,12 +2327,12 @@ bool H264Deserialize::DeserializeSeiFramePackingArrangementSyntax(H26xBinaryRead
 bool H264Deserialize::DeserializeSeiAlternativeTransferCharacteristicsSyntax(H26xBinaryReader::ptr br, H264SeiAlternativeTransferCharacteristicsSyntax::ptr atc)
 {
     // See also : D.1.32 Alternative transfer characteristics SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(8, atc->preferred_transfer_characteristics);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1935,14 +2341,14 @@ bool H264Deserialize::DeserializeSeiAlternativeTransferCharacteristicsSyntax(H26
 bool H264Deserialize::DeserializeAmbientViewingEnvironmentSyntax(H26xBinaryReader::ptr br, H264AmbientViewingEnvironmentSyntax::ptr awe)
 {
     // See also : ISO 14496/10(2020) - D.1.34 Ambient viewing environment SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(32, awe->ambient_illuminance);
         br->U(16, awe->ambient_light_x);
         br->U(16, awe->ambient_light_y);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
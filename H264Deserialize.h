@@ -11,9 +11,17 @@
 #include <cstdint>
 #include <memory>
 #include <vector>
+#include <bitset>
+#include <functional>
 
 #include "H264Common.h"
+#include "H264LazyNalUnit.h"
+#include "H264SyntaxPool.h"
+#include "H264ParameterSetStore.h"
+#include "H26xArena.h"
 #include "H26xBinaryReader.h"
+#include "H26xNalSplitter.h"
+#include "H26xByteStreamFeeder.h"
 
 namespace Mmp
 {
@@ -27,6 +35,11 @@ class H264Deserialize
 {
 public:
     using ptr = std::shared_ptr<H264Deserialize>;
+    /**
+     * @param res : result of DeserializeNalSyntax
+     * @param nal : deserialized NAL unit
+     */
+    using NalUnitCallback = std::function<void(bool res, H264NalSyntax::ptr nal)>;
 public:
     H264Deserialize();
     ~H264Deserialize();
@@ -37,6 +50,112 @@ public:
      */
     bool DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal);
     bool DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal);
+    /**
+     * @brief deserialize one NAL unit (without start code) from contiguous memory
+     * @note  no copy is made, data must stay valid during the call
+     */
+    bool DeserializeNalSyntax(const uint8_t* data, size_t size, H264NalSyntax::ptr nal);
+    /**
+     * @brief deserialize all NAL units of a byte stream (Annex B) held in memory, such as one PES packet
+     * @param nals : deserialized NAL units are appended
+     * @note  start codes are located with H26xNalSplitter, each NAL unit is deserialized in place
+     */
+    bool DeserializeByteStream(const uint8_t* data, size_t size, std::vector<H264NalSyntax::ptr>& nals);
+    /**
+     * @brief decode the NAL unit header only, the body is deserialized on first access,
+     *        see also H264LazyNalUnit
+     * @note  1 - no copy is made, data must stay valid until the body is deserialized
+     *        2 - the current masks apply to the body, the arena is never used
+     */
+    H264LazyNalUnit::ptr DeserializeLazyNalUnit(const uint8_t* data, size_t size);
+public:
+    /**
+     * @brief parameter sets received so far
+     * @note  SetContext() takes ownership, the context is modified by later parameter sets,
+     *        see also H264ParallelDeserialize
+     */
+    H264ContextSyntax::ptr GetContext();
+    void SetContext(H264ContextSyntax::ptr contex);
+    /**
+     * @brief whether the last parameter set (SPS or PPS) deserialized changed the parameter sets in effect
+     * @note  1 - a parameter set byte identical to the one stored with the same id is not deserialized again,
+     *            the stored one is reused (nal->sps or nal->pps) and false is returned
+     *        2 - only NAL units deserialized from memory take the fast path, DeserializeNalSyntax()
+     *            from H26xBinaryReader always deserializes
+     *        3 - a PPS is deserialized again once its SPS has changed
+     */
+    bool ParameterSetChanged();
+    /**
+     * @brief look up and intern parameter sets in store, nullptr to disable (default)
+     * @note  1 - parameter sets deserialized by any deserializer sharing store are not deserialized again,
+     *            the context refers to the interned object, see also H264ParameterSetStore::Global()
+     *        2 - only NAL units deserialized from memory are interned, like the fast path of ParameterSetChanged()
+     */
+    void SetParameterSetStore(H264ParameterSetStore::ptr store);
+public: /* memory */
+    /**
+     * @brief carve per NAL unit syntax (NAL unit, slice header, SEI and their children) from arena,
+     *        nullptr for the heap (default)
+     * @note  1 - parameter sets are kept by the context, they are always on the heap
+     *        2 - syntax from arena shall be released before H26xArena::Reset(), e.g. once per NAL unit or access unit
+     *        3 - the NAL unit passed to DeserializeNalSyntax() is allocated by the caller, see also H26xMakeShared
+     */
+    void SetArena(H26xArena::ptr arena);
+    /**
+     * @brief recycle per NAL unit syntax from pool, nullptr to disable (default)
+     * @note  takes precedence over SetArena(), use H264SyntaxPool::AcquireNalSyntax() for the NAL unit
+     *        passed to DeserializeNalSyntax()
+     */
+    void SetSyntaxPool(H264SyntaxPool::ptr pool);
+    /**
+     * @brief NAL unit syntax from the syntax pool, the arena or the heap, whichever is set
+     * @note  for the NAL unit passed to DeserializeNalSyntax()
+     */
+    H264NalSyntax::ptr MakeNalSyntax();
+public: /* selective deserialization */
+    /**
+     * @brief only NAL units whose type is set in mask are deserialized (bit n for nal_unit_type n), all by default
+     * @note  1 - checked right after the NAL unit header, other NAL units are skipped without syntax parsing
+     *        2 - DeserializeByteStream(), Feed() and DeserializeLengthPrefixedNalUnits() drop them altogether,
+     *            DeserializeNalSyntax() fills the NAL unit header only
+     *        3 - slices need their parameter sets, keep SPS and PPS in mask as long as slices are
+     */
+    void SetNalUnitTypeMask(uint32_t mask);
+    /**
+     * @brief only SEI messages whose payloadType is set in mask are deserialized, all by default
+     * @note  others are skipped by payloadSize, only payloadType and payloadSize are filled
+     */
+    void SetSeiPayloadTypeMask(const std::bitset<256>& mask);
+public: /* push mode */
+    /**
+     * @brief callback invoked for each NAL unit deserialized by Feed() or Flush(), in stream order
+     */
+    void SetNalUnitCallback(const NalUnitCallback& callback);
+    /**
+     * @brief push the next chunk of byte stream (Annex B), chunks may be of any size
+     * @note  a NAL unit is deserialized once the next start code arrives, only the unfinished
+     *        tail of data is buffered, see also H26xByteStreamFeeder
+     * @sa    ISO 14496/10(2020) - B.1.1 Byte stream NAL unit syntax
+     */
+    void Feed(const uint8_t* data, size_t size);
+    /**
+     * @brief end of byte stream, deserialize the last NAL unit
+     */
+    void Flush();
+public: /* length prefixed (AVCC) */
+    /**
+     * @brief deserialize AVCDecoderConfigurationRecord (avcC box of MP4, CodecPrivate of MKV),
+     *        the SPS and PPS within are deserialized into the context as well
+     * @sa    ISO 14496/15(2019) - 5.3.3.1 AVC decoder configuration record
+     */
+    bool DeserializeDecoderConfigurationRecord(const uint8_t* data, size_t size, H264DecoderConfigurationRecordSyntax::ptr record);
+    /**
+     * @brief deserialize NAL units each preceded by its size, such as one MP4/MKV sample
+     * @param lengthSize : size of the length prefix, 1, 2 or 4 (lengthSizeMinusOne + 1 of the decoder configuration record)
+     * @param nals : deserialized NAL units are appended
+     * @note  no start code is searched and no copy is made, each NAL unit is deserialized in place
+     */
+    bool DeserializeLengthPrefixedNalUnits(const uint8_t* data, size_t size, uint8_t lengthSize, std::vector<H264NalSyntax::ptr>& nals);
     bool DeserializeHrdSyntax(H26xBinaryReader::ptr br, H264HrdSyntax::ptr hrd);
     bool DeserializeVuiSyntax(H26xBinaryReader::ptr br, H264VuiSyntax::ptr vui);
     bool DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSyntax::ptr sei);
@@ -51,7 +170,7 @@ private:
     bool DeserializeNalSvcSyntax(H26xBinaryReader::ptr br, H264NalSvcSyntax::ptr svc);
     bool DeserializeNal3dAvcSyntax(H26xBinaryReader::ptr br, H264Nal3dAvcSyntax::ptr avc);
     bool DeserializeNalMvcSyntax(H26xBinaryReader::ptr br, H264NalMvcSyntax::ptr mvc);
-    bool DeserializeScalingListSyntax(H26xBinaryReader::ptr br, std::vector<int32_t>& scalingList, int32_t sizeOfScalingList, int32_t& useDefaultScalingMatrixFlag);
+    bool DeserializeScalingListSyntax(H26xBinaryReader::ptr br, int32_t* scalingList, int32_t sizeOfScalingList, int32_t& useDefaultScalingMatrixFlag);
     bool DeserializeReferencePictureListModificationSyntax(H26xBinaryReader::ptr br, H264SliceHeaderSyntax::ptr slice, H264ReferencePictureListModificationSyntax::ptr rplm);
     bool DeserializePredictionWeightTableSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps, H264SliceHeaderSyntax::ptr slice, H264PredictionWeightTableSyntax::ptr pwt);
 private: /* SEI */
@@ -67,8 +186,30 @@ private: /* SEI */
     bool DeserializeSeiFramePackingArrangementSyntax(H26xBinaryReader::ptr br, H264SeiFramePackingArrangementSyntax::ptr fpa);
     bool DeserializeSeiAlternativeTransferCharacteristicsSyntax(H26xBinaryReader::ptr br, H264SeiAlternativeTransferCharacteristicsSyntax::ptr atc);
     bool DeserializeAmbientViewingEnvironmentSyntax(H26xBinaryReader::ptr br, H264AmbientViewingEnvironmentSyntax::ptr awe);
+private:
+    bool NalUnitTypeEnabled(uint8_t nal_unit_type);
+    bool ReuseParameterSet(const uint8_t* data, size_t size, uint64_t hash, H264NalSyntax::ptr nal);
+    bool FindParameterSet(const uint8_t* data, size_t size, uint64_t hash, H264NalSyntax::ptr nal);
+    void InternParameterSet(const uint8_t* data, size_t size, uint64_t hash, H264NalSyntax::ptr nal);
+    void StoreSps(H264SpsSyntax::ptr sps);
+    void StorePps(H264PpsSyntax::ptr pps);
+    template <typename T>
+    std::shared_ptr<T> MakeSyntax()
+    {
+        return _pool ? _pool->Acquire<T>() : H26xMakeShared<T>(_arena.get());
+    }
 private:
     H264ContextSyntax::ptr _contex;
+    H264ContextSyntax::ptr _lazyContex; // snapshot of _contex shared by lazy NAL units, reset by parameter sets
+    H26xBinaryReader::ptr _spanReader;
+    H26xByteStreamFeeder::ptr _feeder;
+    NalUnitCallback _nalUnitCallback;
+    H26xArena::ptr _arena;
+    H264SyntaxPool::ptr _pool;
+    H264ParameterSetStore::ptr _parameterSetStore;
+    bool _parameterSetChanged;
+    uint32_t _nalUnitTypeMask;
+    std::bitset<256> _seiPayloadTypeMask;
 };
 
 } // namespace Codec
@@ -0,0 +1,94 @@
+#include "H264LazyNalUnit.h"
+
+#include "H264Deserialize.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+static H264Deserialize& LazyNalUnitDeserializer()
+{
+    // Hint : kept by each thread and rebound to the context of every NAL unit, nothing is allocated per NAL unit
+    thread_local H264Deserialize deserialize;
+    return deserialize;
+}
+
+H264LazyNalUnit::H264LazyNalUnit(const uint8_t* data, size_t size, H264ContextSyntax::ptr contex)
+{
+    _data = data;
+    _size = size;
+    _contex = contex;
+    _nal = nullptr;
+    _deserialized = false;
+    _res = false;
+    _nalUnitTypeMask = 0xFFFFFFFF;
+    _seiPayloadTypeMask.set();
+    nal_ref_idc = 0;
+    nal_unit_type = 0;
+}
+
+const uint8_t* H264LazyNalUnit::Data()
+{
+    return _data;
+}
+
+size_t H264LazyNalUnit::Size()
+{
+    return _size;
+}
+
+bool H264LazyNalUnit::Deserialized()
+{
+    return _deserialized;
+}
+
+bool H264LazyNalUnit::Result()
+{
+    Nal();
+    return _res;
+}
+
+H264NalSyntax::ptr H264LazyNalUnit::Nal()
+{
+    if (!_deserialized)
+    {
+        // Hint : on the parameter sets in effect when this NAL unit was created, the context is only read
+        H264Deserialize& deserialize = LazyNalUnitDeserializer();
+        if (!_nal)
+        {
+            _nal = std::make_shared<H264NalSyntax>();
+        }
+        deserialize.SetContext(_contex);
+        deserialize.SetNalUnitTypeMask(_nalUnitTypeMask);
+        deserialize.SetSeiPayloadTypeMask(_seiPayloadTypeMask);
+        _res = deserialize.DeserializeNalSyntax(_data, _size, _nal);
+        deserialize.SetContext(nullptr);
+        _contex = nullptr;
+        _deserialized = true;
+    }
+    return _nal;
+}
+
+H264SpsSyntax::ptr H264LazyNalUnit::Sps()
+{
+    return Nal()->sps;
+}
+
+H264PpsSyntax::ptr H264LazyNalUnit::Pps()
+{
+    return Nal()->pps;
+}
+
+H264SeiSyntax::ptr H264LazyNalUnit::Sei()
+{
+    return Nal()->sei;
+}
+
+H264SliceHeaderSyntax::ptr H264LazyNalUnit::Slice()
+{
+    return Nal()->slice;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
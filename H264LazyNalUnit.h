@@ -0,0 +1,81 @@
+//
+// H264LazyNalUnit.h
+//
+// Library: Codec
+// Package: H264
+// Module:  H264
+// 
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <memory>
+
+#include "H264Common.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief NAL unit whose header is decoded up front and whose body is deserialized on first access
+ * @note  1 - created by H264Deserialize::DeserializeLazyNalUnit()
+ *        2 - no copy is made, data must stay valid until the body is deserialized (or never accessed)
+ *        3 - parameter sets are always deserialized up front, later NAL units depend on them;
+ *            other NAL units keep the parameter sets in effect when they were created
+ *        4 - the body is deserialized by the thread calling the first accessor, with a deserializer kept by
+ *            that thread; NAL units may be accessed from different threads, one NAL unit shall not be
+ *            accessed concurrently
+ *        5 - the NAL unit syntax comes from the pool of the creating deserializer, never from its arena
+ *            which is not thread safe, see also H264Deserialize::SetSyntaxPool()
+ *        6 - NAL unit types and SEI payload types are masked as set on the creating deserializer
+ *            when the NAL unit was created
+ * @sa    ISO 14496/10(2020) - 7.3.1 NAL unit syntax
+ */
+class H264LazyNalUnit
+{
+public:
+    using ptr = std::shared_ptr<H264LazyNalUnit>;
+public:
+    H264LazyNalUnit(const uint8_t* data, size_t size, H264ContextSyntax::ptr contex);
+    ~H264LazyNalUnit() = default;
+public:
+    const uint8_t* Data();
+    size_t Size();
+    /**
+     * @brief whether the body has been deserialized
+     */
+    bool Deserialized();
+    /**
+     * @brief result of body deserialization, deserialize it if not yet
+     */
+    bool Result();
+public:
+    /**
+     * @brief fully deserialized NAL unit, deserialize it if not yet
+     */
+    H264NalSyntax::ptr Nal();
+    H264SpsSyntax::ptr Sps();
+    H264PpsSyntax::ptr Pps();
+    H264SeiSyntax::ptr Sei();
+    H264SliceHeaderSyntax::ptr Slice();
+public:
+    uint8_t  nal_ref_idc;
+    uint8_t  nal_unit_type;
+private:
+    friend class H264Deserialize;
+private:
+    const uint8_t*         _data;
+    size_t                 _size;
+    H264ContextSyntax::ptr _contex;
+    H264NalSyntax::ptr     _nal;
+    bool                   _deserialized;
+    bool                   _res;
+    uint32_t               _nalUnitTypeMask;
+    std::bitset<256>       _seiPayloadTypeMask;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
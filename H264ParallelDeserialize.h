@@ -0,0 +1,58 @@
+//
+// H264ParallelDeserialize.h
+//
+// Library: Codec
+// Package: H264
+// Module:  H264
+// 
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "H264Common.h"
+#include "H264Deserialize.h"
+#include "H26xThreadPool.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief deserialize a whole byte stream with a thread pool, for batch analysis of long streams
+ * @note  1 - NAL units are located by H26xNalSplitter first
+ *        2 - SPS and PPS are deserialized sequentially, each one yields an immutable snapshot of the context
+ *        3 - other NAL units (slice headers, SEI) are deserialized by the pool, each thread has its own
+ *            H264Deserialize (hence its own bit reader) running on a private copy of the snapshot in effect
+ *        4 - results are stored by NAL unit number, i.e. in stream order
+ *        5 - parameter sets are kept from one call to the next, as H264Deserialize does
+ * @sa    ISO 14496/10(2020) - 7.4.1.2.1 Order of sequence and picture parameter set RBSPs and their activation
+ */
+class H264ParallelDeserialize
+{
+public:
+    using ptr = std::shared_ptr<H264ParallelDeserialize>;
+public:
+    /**
+     * @param threadNum : 0 for std::thread::hardware_concurrency()
+     */
+    explicit H264ParallelDeserialize(size_t threadNum = 0);
+    ~H264ParallelDeserialize() = default;
+public:
+    /**
+     * @brief deserialize all NAL units of a byte stream (Annex B) held in memory
+     * @param nals : deserialized NAL units are appended, in stream order
+     * @param res  : result of each NAL unit is appended (optional)
+     */
+    bool DeserializeByteStream(const uint8_t* data, size_t size, std::vector<H264NalSyntax::ptr>& nals, std::vector<bool>* res = nullptr);
+private:
+    H26xThreadPool::ptr               _pool;
+    H264Deserialize::ptr              _deserialize; // parameter sets pass
+    std::vector<H264Deserialize::ptr> _workers;     // one per pool thread
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
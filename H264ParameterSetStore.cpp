@@ -0,0 +1,15 @@
+#include "H264ParameterSetStore.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H264ParameterSetStore::ptr H264ParameterSetStore::Global()
+{
+    static H264ParameterSetStore::ptr store = std::make_shared<H264ParameterSetStore>();
+    return store;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,46 @@
+//
+// H264ParameterSetStore.h
+//
+// Library: Codec
+// Package: H264
+// Module:  H264
+// 
+
+#pragma once
+
+#include <memory>
+
+#include "H264Common.h"
+#include "H26xParameterSetTable.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief parameter sets interned across streams, each byte identical parameter set is deserialized once
+ *        and every context refers to the same object
+ * @note  1 - thread safe, one store may be shared by any number of deserializers, see also H264Deserialize::SetParameterSetStore()
+ *        2 - interned parameter sets shall never be modified
+ *        3 - PPS are shared between streams whose SPS is the same interned one
+ */
+class H264ParameterSetStore
+{
+public:
+    using ptr = std::shared_ptr<H264ParameterSetStore>;
+public:
+    H264ParameterSetStore() = default;
+    ~H264ParameterSetStore() = default;
+public:
+    /**
+     * @brief store shared by the whole process
+     */
+    static H264ParameterSetStore::ptr Global();
+public:
+    H26xParameterSetTable<H264SpsSyntax> spsTable;
+    H26xParameterSetTable<H264PpsSyntax> ppsTable;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "H264SyntaxPool.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H264SyntaxPool::H264SyntaxPool(size_t maxNalCount)
+{
+    _maxNalCount = maxNalCount;
+    _cursor = 0;
+}
+
+H264NalSyntax::ptr H264SyntaxPool::AcquireNalSyntax()
+{
+    // Hint : round robin from the last one handed out, NAL units are usually released in order
+    for (size_t i=0; i<_nals.size(); i++)
+    {
+        size_t index = (_cursor + i) % _nals.size();
+        if (_nals[index].use_count() == 1)
+        {
+            ResetSyntax(*_nals[index]);
+            _cursor = index + 1;
+            return _nals[index];
+        }
+    }
+    H264NalSyntax::ptr nal = std::make_shared<H264NalSyntax>();
+    if (_nals.size() < _maxNalCount)
+    {
+        _nals.push_back(nal);
+        _cursor = 0;
+    }
+    return nal;
+}
+
+void H264SyntaxPool::ResetSyntax(H264NalSyntax& nal)
+{
+    Recycle(nal.svc);
+    Recycle(nal.avc);
+    Recycle(nal.mvc);
+    Recycle(nal.slice);
+    Recycle(nal.sei);
+    nal = H264NalSyntax();
+}
+
+void H264SyntaxPool::ResetSyntax(H264SliceHeaderSyntax& slice)
+{
+    Recycle(slice.rplm);
+    Recycle(slice.pwt);
+    Recycle(slice.drpm);
+    slice = H264SliceHeaderSyntax();
+}
+
+void H264SyntaxPool::ResetSyntax(H264SeiSyntax& sei)
+{
+    Recycle(sei.bp);
+    Recycle(sei.pt);
+    Recycle(sei.rp);
+    Recycle(sei.clli);
+    Recycle(sei.dot);
+    Recycle(sei.fg);
+    Recycle(sei.fpa);
+    Recycle(sei.mpvc);
+    Recycle(sei.udr);
+    Recycle(sei.udn);
+    Recycle(sei.atc);
+    Recycle(sei.awe);
+    sei = H264SeiSyntax();
+}
+
+void H264SyntaxPool::ResetSyntax(H264ReferencePictureListModificationSyntax& rplm)
+{
+    rplm.Reset();
+}
+
+void H264SyntaxPool::ResetSyntax(H264PredictionWeightTableSyntax& pwt)
+{
+    pwt.Reset();
+}
+
+void H264SyntaxPool::ResetSyntax(H264DecodedReferencePictureMarkingSyntax& drpm)
+{
+    drpm.Reset();
+}
+
+void H264SyntaxPool::ResetSyntax(H264SeiBufferPeriodSyntax& bp)
+{
+    bp.Reset();
+}
+
+void H264SyntaxPool::ResetSyntax(H264SeiPictureTimingSyntax& pt)
+{
+    pt.Reset();
+}
+
+void H264SyntaxPool::ResetSyntax(H264SeiUserDataRegisteredSyntax& udr)
+{
+    udr.Reset();
+}
+
+void H264SyntaxPool::ResetSyntax(H264SeiUserDataUnregisteredSyntax& udn)
+{
+    udn.Reset();
+}
+
+void H264SyntaxPool::ResetSyntax(H264SeiFilmGrainSyntax& fg)
+{
+    fg.Reset();
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
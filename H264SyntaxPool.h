@@ -0,0 +1,112 @@
+//
+// H264SyntaxPool.h
+//
+// Library: Codec
+// Package: H264
+// Module:  H264
+//
+
+#pragma once
+
+#include <tuple>
+#include <memory>
+#include <vector>
+
+#include "H264Common.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief recycle per NAL unit syntax trees instead of reallocating them
+ * @note  1 - AcquireNalSyntax() hands out a NAL unit no longer referenced outside the pool, its children
+ *            (slice header, SEI and so on) go back to the pool and every field is reset
+ *        2 - recycled vectors are cleared but keep their capacity, in steady state deserializing a long stream
+ *            makes no heap allocation for per NAL unit syntax
+ *        3 - a syntax object still referenced elsewhere is never recycled, parameter sets are kept by the context
+ *            and are never recycled
+ *        4 - not thread safe, one pool per deserializer, see also H264Deserialize::SetSyntaxPool()
+ */
+class H264SyntaxPool
+{
+public:
+    using ptr = std::shared_ptr<H264SyntaxPool>;
+public:
+    /**
+     * @param maxNalCount : NAL units tracked by the pool, NAL units acquired beyond are not recycled
+     */
+    explicit H264SyntaxPool(size_t maxNalCount = 16);
+    ~H264SyntaxPool() = default;
+public:
+    H264NalSyntax::ptr AcquireNalSyntax();
+    template <typename T>
+    std::shared_ptr<T> Acquire()
+    {
+        std::vector<std::shared_ptr<T>>& bin = std::get<std::vector<std::shared_ptr<T>>>(_bins);
+        if (bin.empty())
+        {
+            return std::make_shared<T>();
+        }
+        std::shared_ptr<T> syntax = std::move(bin.back());
+        bin.pop_back();
+        return syntax;
+    }
+private:
+    template <typename T>
+    void Recycle(std::shared_ptr<T>& syntax)
+    {
+        if (syntax && syntax.use_count() == 1)
+        {
+            ResetSyntax(*syntax);
+            std::get<std::vector<std::shared_ptr<T>>>(_bins).push_back(std::move(syntax));
+        }
+        syntax = nullptr;
+    }
+    template <typename T>
+    void ResetSyntax(T& syntax)
+    {
+        syntax = T();
+    }
+    void ResetSyntax(H264NalSyntax& nal);
+    void ResetSyntax(H264SliceHeaderSyntax& slice);
+    void ResetSyntax(H264SeiSyntax& sei);
+    void ResetSyntax(H264ReferencePictureListModificationSyntax& rplm);
+    void ResetSyntax(H264PredictionWeightTableSyntax& pwt);
+    void ResetSyntax(H264DecodedReferencePictureMarkingSyntax& drpm);
+    void ResetSyntax(H264SeiBufferPeriodSyntax& bp);
+    void ResetSyntax(H264SeiPictureTimingSyntax& pt);
+    void ResetSyntax(H264SeiUserDataRegisteredSyntax& udr);
+    void ResetSyntax(H264SeiUserDataUnregisteredSyntax& udn);
+    void ResetSyntax(H264SeiFilmGrainSyntax& fg);
+private:
+    size_t                          _maxNalCount;
+    size_t                          _cursor;
+    std::vector<H264NalSyntax::ptr> _nals;
+    std::tuple<
+        std::vector<H264NalSvcSyntax::ptr>,
+        std::vector<H264Nal3dAvcSyntax::ptr>,
+        std::vector<H264NalMvcSyntax::ptr>,
+        std::vector<H264SliceHeaderSyntax::ptr>,
+        std::vector<H264ReferencePictureListModificationSyntax::ptr>,
+        std::vector<H264PredictionWeightTableSyntax::ptr>,
+        std::vector<H264DecodedReferencePictureMarkingSyntax::ptr>,
+        std::vector<H264SeiSyntax::ptr>,
+        std::vector<H264SeiBufferPeriodSyntax::ptr>,
+        std::vector<H264SeiPictureTimingSyntax::ptr>,
+        std::vector<H264SeiUserDataRegisteredSyntax::ptr>,
+        std::vector<H264SeiUserDataUnregisteredSyntax::ptr>,
+        std::vector<H264SeiRecoveryPointSyntax::ptr>,
+        std::vector<H264SeiContentLigntLevelInfoSyntax::ptr>,
+        std::vector<H264SeiDisplayOrientationSyntax::ptr>,
+        std::vector<H264SeiFilmGrainSyntax::ptr>,
+        std::vector<H264SeiFramePackingArrangementSyntax::ptr>,
+        std::vector<H264SeiAlternativeTransferCharacteristicsSyntax::ptr>,
+        std::vector<H264AmbientViewingEnvironmentSyntax::ptr>,
+        std::vector<H264MasteringDisplayColourVolumeSyntax::ptr>
+    > _bins;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
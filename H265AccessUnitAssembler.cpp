@@ -0,0 +1,134 @@
+#include "H265AccessUnitAssembler.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H265AccessUnitNalUnit::H265AccessUnitNalUnit()
+{
+    offset = 0;
+    size = 0;
+    first_slice_of_picture = 0;
+    res = false;
+}
+
+H265AccessUnit::H265AccessUnit()
+{
+    keyframe = 0;
+    reference = 0;
+}
+
+H265AccessUnitAssembler::H265AccessUnitAssembler(const AccessUnitCallback& callback, H265Deserialize::ptr deserialize)
+{
+    _callback = callback;
+    _deserialize = deserialize ? deserialize : std::make_shared<H265Deserialize>();
+    _feeder = std::make_shared<H26xByteStreamFeeder>([this](const uint8_t* data, size_t size) -> void
+    {
+        PushNalUnit(data, size);
+    });
+    _hasVcl = false;
+    _lastAuSize = 0;
+}
+
+bool H265AccessUnitAssembler::PushNalUnit(const uint8_t* data, size_t size)
+{
+    H265NalSyntax::ptr nal = _deserialize->MakeNalSyntax();
+    bool res = _deserialize->DeserializeNalSyntax(data, size, nal);
+    bool firstSliceOfPicture = false;
+    uint8_t nal_unit_type = nal->header ? nal->header->nal_unit_type : 0xFF;
+    uint8_t nuh_layer_id = nal->header ? nal->header->nuh_layer_id : 0;
+    if (nal_unit_type <= 31 /* VCL */)
+    {
+        firstSliceOfPicture = nal->slice && nal->slice->first_slice_segment_in_pic_flag && nuh_layer_id == 0;
+        if (firstSliceOfPicture && _hasVcl)
+        {
+            ReportAccessUnit();
+        }
+        _hasVcl = true;
+    }
+    else if (nuh_layer_id == 0 &&
+             ((nal_unit_type >= H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT && nal_unit_type <= H265NaluType::MMP_H265_NALU_TYPE_AUD_NUT) ||
+              nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_PREFIX_SEI_NUT ||
+              (nal_unit_type >= 41 && nal_unit_type <= 44) /* reserved */ ||
+              (nal_unit_type >= 48 && nal_unit_type <= 55) /* unspecified */
+             )
+    )
+    {
+        if (_hasVcl)
+        {
+            ReportAccessUnit();
+        }
+    }
+    if (!_au && _spareAu)
+    {
+        _au = _spareAu;
+        _spareAu = nullptr;
+    }
+    else if (!_au)
+    {
+        _au = std::make_shared<H265AccessUnit>();
+        _au->data.reserve(_lastAuSize);
+    }
+    if (firstSliceOfPicture)
+    {
+        // See also : ITU-T H.265 (2021) - 7.4.2.2 NAL unit header semantics (IRAP, sub-layer non-reference picture)
+        _au->keyframe = nal_unit_type >= H265NaluType::MMP_H265_NALU_TYPE_BLA_W_LP && nal_unit_type <= H265NaluType::MMP_H265_NALU_TYPE_RSV_IRAP_VCL23;
+        _au->reference = !(nal_unit_type <= H265NaluType::MMP_H265_NALU_TYPE_RSV_VCL_N14T && nal_unit_type % 2 == 0);
+    }
+    H265AccessUnitNalUnit nalUnit;
+    _au->data.insert(_au->data.end(), {0x00, 0x00, 0x00, 0x01});
+    nalUnit.offset = _au->data.size();
+    nalUnit.size = size;
+    nalUnit.first_slice_of_picture = firstSliceOfPicture;
+    nalUnit.res = res;
+    nalUnit.nal = nal;
+    _au->data.insert(_au->data.end(), data, data + size);
+    _au->nals.push_back(nalUnit);
+    return res;
+}
+
+void H265AccessUnitAssembler::Feed(const uint8_t* data, size_t size)
+{
+    _feeder->Feed(data, size);
+}
+
+void H265AccessUnitAssembler::Flush()
+{
+    _feeder->Flush();
+    ReportAccessUnit();
+}
+
+void H265AccessUnitAssembler::Reset()
+{
+    _feeder->Reset();
+    _au = nullptr;
+    _hasVcl = false;
+}
+
+void H265AccessUnitAssembler::ReportAccessUnit()
+{
+    H265AccessUnit::ptr au = _au;
+    _au = nullptr;
+    _hasVcl = false;
+    if (au)
+    {
+        _lastAuSize = au->data.size();
+    }
+    if (au && _callback)
+    {
+        _callback(au);
+    }
+    // Hint : once released by the callback, data and nals are cleared but keep their capacity
+    if (au && au.use_count() == 1)
+    {
+        au->keyframe = 0;
+        au->reference = 0;
+        au->data.clear();
+        au->nals.clear();
+        _spareAu = au;
+    }
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
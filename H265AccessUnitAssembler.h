@@ -0,0 +1,111 @@
+//
+// H265AccessUnitAssembler.h
+//
+// Library: Codec
+// Package: H265
+// Module:  H265
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "H265Common.h"
+#include "H265Deserialize.h"
+#include "H26xByteStreamFeeder.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief one NAL unit of an access unit, a view into H265AccessUnit::data
+ */
+class H265AccessUnitNalUnit
+{
+public:
+    H265AccessUnitNalUnit();
+    ~H265AccessUnitNalUnit() = default;
+public:
+    size_t  offset;                 // offset in H265AccessUnit::data of the NAL unit (start code excluded)
+    size_t  size;
+    uint8_t first_slice_of_picture; // picture boundary, first VCL NAL unit of the coded picture (first_slice_segment_in_pic_flag)
+    bool    res;                    // result of DeserializeNalSyntax
+    H265NalSyntax::ptr nal;
+};
+
+/**
+ * @sa ITU-T H.265 (2021) - 7.4.2.4.4 Order of NAL units and coded pictures and their association to access units
+ */
+class H265AccessUnit
+{
+public:
+    using ptr = std::shared_ptr<H265AccessUnit>;
+public:
+    H265AccessUnit();
+    ~H265AccessUnit() = default;
+public:
+    uint8_t keyframe;  // IRAP picture
+    uint8_t reference; // not a sub-layer non-reference picture
+    /**
+     * @brief NAL units of the access unit, each one preceded by a 4 bytes start code (Annex B)
+     */
+    std::vector<uint8_t>               data;
+    std::vector<H265AccessUnitNalUnit> nals;
+};
+
+/**
+ * @brief group NAL units into access units, one batch per coded picture
+ * @note  1 - the first of AUD, VPS, SPS, PPS, prefix SEI, NAL unit types 41 to 44 and 48 to 55 (with nuh_layer_id 0)
+ *            or the first VCL NAL unit of a coded picture, following the last VCL NAL unit of a coded picture,
+ *            starts a new access unit
+ *        2 - the first VCL NAL unit of a coded picture has first_slice_segment_in_pic_flag set
+ *        3 - an access unit is reported once the next one begins, or on Flush()
+ *        4 - slice segment headers are required, keep slices, VPS, SPS and PPS in H265Deserialize::SetNalUnitTypeMask()
+ *        5 - NAL unit syntax is made by the deserializer, see also H265Deserialize::SetSyntaxPool(); an access unit
+ *            no longer referenced once the callback returns is recycled for the next one
+ */
+class H265AccessUnitAssembler
+{
+public:
+    using ptr = std::shared_ptr<H265AccessUnitAssembler>;
+    using AccessUnitCallback = std::function<void(H265AccessUnit::ptr au)>;
+public:
+    /**
+     * @param deserialize : nullptr to use a private one
+     */
+    explicit H265AccessUnitAssembler(const AccessUnitCallback& callback, H265Deserialize::ptr deserialize = nullptr);
+    ~H265AccessUnitAssembler() = default;
+public:
+    /**
+     * @brief push one NAL unit (without start code), such as from H26xRtpDepacketizer or a length prefixed sample
+     * @note  data is copied into the access unit
+     */
+    bool PushNalUnit(const uint8_t* data, size_t size);
+    /**
+     * @brief push the next chunk of byte stream (Annex B), chunks may be of any size
+     */
+    void Feed(const uint8_t* data, size_t size);
+    /**
+     * @brief end of stream, the last access unit (if any) is reported
+     */
+    void Flush();
+    void Reset();
+private:
+    void ReportAccessUnit();
+private:
+    AccessUnitCallback        _callback;
+    H265Deserialize::ptr      _deserialize;
+    H26xByteStreamFeeder::ptr _feeder;
+    H265AccessUnit::ptr       _au;
+    H265AccessUnit::ptr       _spareAu;  // last access unit reported and released, recycled with its capacity
+    size_t                    _lastAuSize;
+    bool                      _hasVcl;   // _au holds a VCL NAL unit of a coded picture
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
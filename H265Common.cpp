@@ -8,6 +8,11 @@ namespace Codec
 {
 
 H265StRefPicSetSyntax::H265StRefPicSetSyntax()
+{
+    Reset();
+}
+
+void H265StRefPicSetSyntax::Reset()
 {
     inter_ref_pic_set_prediction_flag = 0;
     delta_idx_minus1 = 0;
@@ -15,6 +20,12 @@ H265StRefPicSetSyntax::H265StRefPicSetSyntax()
     abs_delta_rps_minus1 = 0;
     num_negative_pics = 0;
     num_positive_pics = 0;
+    used_by_curr_pic_flag.clear();
+    use_delta_flag.clear();
+    delta_poc_s0_minus1.clear();
+    used_by_curr_pic_s0_flag.clear();
+    delta_poc_s1_minus1.clear();
+    used_by_curr_pic_s1_flag.clear();
 }
 
 H265SpsRangeSyntax::H265SpsRangeSyntax()
@@ -370,18 +381,64 @@ H265PpsMultilayerExtensionSyntax::H265PpsMultilayerExtensionSyntax()
 }
 
 H265RefPicListsModificationSyntax::H265RefPicListsModificationSyntax()
+{
+    Reset();
+}
+
+void H265RefPicListsModificationSyntax::Reset()
 {
     ref_pic_list_modification_flag_l0 = 0;
     ref_pic_list_modification_flag_l1 = 0;
+    list_entry_l0.clear();
+    list_entry_l1.clear();
+}
+
+H265ScalingListDataSyntax::H265ScalingListDataSyntax()
+{
+    for (size_t sizeId=0; sizeId<4; sizeId++)
+    {
+        scaling_list_pred_mode_flag[sizeId].fill(0);
+        scaling_list_pred_matrix_id_delta[sizeId].fill(0);
+        for (auto& scalingList : ScalingList[sizeId])
+        {
+            scalingList.fill(0);
+        }
+    }
+    for (auto& dcCoef : scaling_list_dc_coef_minus8)
+    {
+        dcCoef.fill(0);
+    }
 }
 
 H265PredWeightTableSyntax::H265PredWeightTableSyntax()
+{
+    Reset();
+}
+
+void H265PredWeightTableSyntax::Reset()
 {
     luma_log2_weight_denom = 0;
     delta_chroma_log2_weight_denom = 0;
+    luma_weight_l0_flag.fill(0);
+    chroma_weight_l0_flag.fill(0);
+    delta_luma_weight_l0.fill(0);
+    luma_offset_l0.fill(0);
+    delta_chroma_weight_l0.fill({0, 0});
+    delta_chroma_offset_l0.fill({0, 0});
+    luma_weight_l1_flag.fill(0);
+    chroma_weight_l1_flag.fill(0);
+    delta_luma_weight_l1.fill(0);
+    luma_offset_l1.fill(0);
+    delta_chroma_weight_l1.fill({0, 0});
+    delta_chroma_offset_l1.fill({0, 0});
 }
 
 H265SliceHeaderSyntax::H265SliceHeaderSyntax()
+{
+    Reset();
+}
+
+void H265SliceHeaderSyntax::Reset()
 {
     first_slice_segment_in_pic_flag = 0;
     no_output_of_prior_pics_flag = 0;
@@ -423,6 +480,17 @@ H265SliceHeaderSyntax::H265SliceHeaderSyntax()
     num_entry_point_offsets = 0;
     offset_len_minus1 = 0;
     slice_segment_header_extension_length = 0;
+    slice_reserved_flag.clear();
+    lt_idx_sps.clear();
+    poc_lsb_lt.clear();
+    used_by_curr_pic_lt_flag.clear();
+    delta_poc_msb_present_flag.clear();
+    delta_poc_msb_cycle_lt.clear();
+    entry_point_offset_minus1.clear();
+    slice_segment_header_extension_data_byte.clear();
+    stps = nullptr;
+    rplm = nullptr;
+    pwt = nullptr;
 }
 
 H264SeiPicTimingSyntax::H264SeiPicTimingSyntax()
@@ -470,6 +538,35 @@ H265NalUnitHeaderSyntax::H265NalUnitHeaderSyntax()
     nuh_temporal_id_plus1 = 0;
 }
 
+H265DecoderConfigurationRecordArraySyntax::H265DecoderConfigurationRecordArraySyntax()
+{
+    array_completeness = 0;
+    NAL_unit_type = 0;
+    numNalus = 0;
+}
+
+H265DecoderConfigurationRecordSyntax::H265DecoderConfigurationRecordSyntax()
+{
+    configurationVersion = 0;
+    general_profile_space = 0;
+    general_tier_flag = 0;
+    general_profile_idc = 0;
+    general_profile_compatibility_flags = 0;
+    general_constraint_indicator_flags = 0;
+    general_level_idc = 0;
+    min_spatial_segmentation_idc = 0;
+    parallelismType = 0;
+    chromaFormat = 1;
+    bitDepthLumaMinus8 = 0;
+    bitDepthChromaMinus8 = 0;
+    avgFrameRate = 0;
+    constantFrameRate = 0;
+    numTemporalLayers = 0;
+    temporalIdNested = 0;
+    lengthSizeMinusOne = 3;
+    numOfArrays = 0;
+}
+
 H265ContextSyntax::H265ContextSyntax()
 {
     
@@ -10,11 +10,14 @@
 
 #include <cstdint>
 #include <map>
+#include <array>
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 
+#include "H26xUltis.h"
+
 namespace Mmp
 {
 namespace Codec
@@ -80,6 +83,7 @@ public:
 public:
     H265StRefPicSetSyntax();
     ~H265StRefPicSetSyntax() = default;
+    void Reset();
 public:
     uint8_t  inter_ref_pic_set_prediction_flag;
     uint32_t delta_idx_minus1;
@@ -105,13 +109,14 @@ class H265ScalingListDataSyntax
 public:
     using ptr = std::shared_ptr<H265ScalingListDataSyntax>;
 public:
-    H265ScalingListDataSyntax() = default;
+    H265ScalingListDataSyntax();
     ~H265ScalingListDataSyntax() = default;
 public:
-    std::vector<std::vector<uint8_t>>   scaling_list_pred_mode_flag;
-    std::vector<std::vector<uint32_t>>  scaling_list_pred_matrix_id_delta;
-    std::vector<std::vector<int32_t>>   scaling_list_dc_coef_minus8;
-    std::vector<std::vector<std::vector<uint8_t>>> ScalingList;  
+    // Hint : indexed by [sizeId][matrixId], see also 7.4.5 Scaling list data semantics
+    std::array<std::array<uint8_t, 6>, 4>   scaling_list_pred_mode_flag;
+    std::array<std::array<uint32_t, 6>, 4>  scaling_list_pred_matrix_id_delta;
+    std::array<std::array<int32_t, 6>, 2>   scaling_list_dc_coef_minus8;  // [sizeId - 2][matrixId]
+    std::array<std::array<std::array<uint8_t, 64>, 6>, 4> ScalingList;
 };
 
 /**
@@ -737,6 +742,7 @@ public:
 public:
     H265RefPicListsModificationSyntax();
     ~H265RefPicListsModificationSyntax() = default;
+    void Reset();
 public:
     uint8_t  ref_pic_list_modification_flag_l0;
     std::vector<uint32_t> list_entry_l0;
@@ -754,21 +760,23 @@ public:
 public:
     H265PredWeightTableSyntax();
     ~H265PredWeightTableSyntax() = default;
+    void Reset();
 public:
     uint32_t luma_log2_weight_denom;
     int32_t  delta_chroma_log2_weight_denom;
-    std::vector<uint8_t> luma_weight_l0_flag;
-    std::vector<uint8_t> chroma_weight_l0_flag;
-    std::vector<int32_t> delta_luma_weight_l0;
-    std::vector<int32_t> luma_offset_l0;
-    std::vector<std::vector<int32_t>> delta_chroma_weight_l0;
-    std::vector<std::vector<int32_t>> delta_chroma_offset_l0;
-    std::vector<uint8_t> luma_weight_l1_flag;
-    std::vector<uint8_t> chroma_weight_l1_flag;
-    std::vector<int32_t> delta_luma_weight_l1;
-    std::vector<int32_t> luma_offset_l1;
-    std::vector<std::vector<int32_t>> delta_chroma_weight_l1;
-    std::vector<std::vector<int32_t>> delta_chroma_offset_l1;
+    // Hint : num_ref_idx_lX_active_minus1 + 1 entries are valid, num_ref_idx_lX_active_minus1 is at most 14
+    std::array<uint8_t, 15> luma_weight_l0_flag;
+    std::array<uint8_t, 15> chroma_weight_l0_flag;
+    std::array<int32_t, 15> delta_luma_weight_l0;
+    std::array<int32_t, 15> luma_offset_l0;
+    std::array<std::array<int32_t, 2>, 15> delta_chroma_weight_l0;
+    std::array<std::array<int32_t, 2>, 15> delta_chroma_offset_l0;
+    std::array<uint8_t, 15> luma_weight_l1_flag;
+    std::array<uint8_t, 15> chroma_weight_l1_flag;
+    std::array<int32_t, 15> delta_luma_weight_l1;
+    std::array<int32_t, 15> luma_offset_l1;
+    std::array<std::array<int32_t, 2>, 15> delta_chroma_weight_l1;
+    std::array<std::array<int32_t, 2>, 15> delta_chroma_offset_l1;
 };
 
 /**
@@ -781,6 +789,7 @@ public:
 public:
     H265SliceHeaderSyntax();
     ~H265SliceHeaderSyntax() = default;
+    void Reset();
 public:
     uint8_t  first_slice_segment_in_pic_flag;
     uint8_t  no_output_of_prior_pics_flag;
@@ -974,6 +983,56 @@ public:
     H265SliceHeaderSyntax::ptr   slice;
 };
 
+/**
+ * @sa ISO 14496/15(2019) - 8.3.3.1 HEVC decoder configuration record
+ */
+class H265DecoderConfigurationRecordArraySyntax
+{
+public:
+    using ptr = std::shared_ptr<H265DecoderConfigurationRecordArraySyntax>;
+public:
+    H265DecoderConfigurationRecordArraySyntax();
+    ~H265DecoderConfigurationRecordArraySyntax() = default;
+public:
+    uint8_t  array_completeness;
+    uint8_t  NAL_unit_type;
+    uint16_t numNalus;
+    std::vector<H265NalSyntax::ptr> nalUnits;
+};
+
+/**
+ * @brief decoder configuration of length prefixed (HVCC) streams, such as hvcC box of MP4
+ * @sa    ISO 14496/15(2019) - 8.3.3.1 HEVC decoder configuration record
+ */
+class H265DecoderConfigurationRecordSyntax
+{
+public:
+    using ptr = std::shared_ptr<H265DecoderConfigurationRecordSyntax>;
+public:
+    H265DecoderConfigurationRecordSyntax();
+    ~H265DecoderConfigurationRecordSyntax() = default;
+public:
+    uint8_t  configurationVersion;
+    uint8_t  general_profile_space;
+    uint8_t  general_tier_flag;
+    uint8_t  general_profile_idc;
+    uint32_t general_profile_compatibility_flags;
+    uint64_t general_constraint_indicator_flags;
+    uint8_t  general_level_idc;
+    uint16_t min_spatial_segmentation_idc;
+    uint8_t  parallelismType;
+    uint8_t  chromaFormat;
+    uint8_t  bitDepthLumaMinus8;
+    uint8_t  bitDepthChromaMinus8;
+    uint16_t avgFrameRate;
+    uint8_t  constantFrameRate;
+    uint8_t  numTemporalLayers;
+    uint8_t  temporalIdNested;
+    uint8_t  lengthSizeMinusOne;
+    uint8_t  numOfArrays;
+    std::vector<H265DecoderConfigurationRecordArraySyntax::ptr> arrays;
+};
+
 class H265ContextSyntax
 {
 public:
@@ -985,6 +1044,10 @@ public:
     std::unordered_map<int32_t, H265VPSSyntax::ptr> vpsSet;
     std::unordered_map<int32_t, H265SpsSyntax::ptr> spsSet;
     std::unordered_map<int32_t, H265PpsSyntax::ptr> ppsSet;
+    // Hint : NAL units vpsSet, spsSet and ppsSet are deserialized from, see also H265Deserialize::ParameterSetChanged()
+    std::unordered_map<int32_t, H26xParameterSetData::ptr> vpsData;
+    std::unordered_map<int32_t, H26xParameterSetData::ptr> spsData;
+    std::unordered_map<int32_t, H26xParameterSetData::ptr> ppsData;
 };
 
 } // namespace Codec
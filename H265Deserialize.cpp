@@ -17,52 +17,498 @@ namespace Codec
 H265Deserialize::H265Deserialize()
 {
     _contex = std::make_shared<H265ContextSyntax>();
+    _parameterSetChanged = false;
+    _nalUnitTypeMask = 0xFFFFFFFFFFFFFFFF;
+}
+
+bool H265Deserialize::DeserializeByteStream(const uint8_t* data, size_t size, std::vector<H265NalSyntax::ptr>& nals)
+{
+    std::vector<H26xNalUnitInfo> infos;
+    H26xNalSplitter::Split(data, size, infos);
+    bool res = true;
+    for (const H26xNalUnitInfo& info : infos)
+    {
+        if (!NalUnitTypeEnabled((info.header >> 1) & 0x3F))
+        {
+            continue;
+        }
+        H265NalSyntax::ptr nal = MakeNalSyntax();
+        if (!DeserializeNalSyntax(data + info.offset, info.size, nal))
+        {
+            res = false;
+        }
+        nals.push_back(nal);
+    }
+    return res;
+}
+
+H265LazyNalUnit::ptr H265Deserialize::DeserializeLazyNalUnit(const uint8_t* data, size_t size)
+{
+    if (size < 2)
+    {
+        H26x_LOG_ERROR << "[H265] truncated NAL unit header" << H26x_LOG_TERMINATOR;
+        return nullptr;
+    }
+    // Hint : lazy NAL units may be released by any thread, never carve them from the arena
+    H26xArena::ptr arena = std::move(_arena);
+    // See also : ITU-T H.265 (2021) - 7.3.1.2 NAL unit header syntax
+    uint8_t nal_unit_type = (data[0] >> 1) & 0x3F;
+    uint8_t nuh_layer_id = (uint8_t)(((data[0] & 0x01) << 5) | (data[1] >> 3));
+    uint8_t nuh_temporal_id_plus1 = data[1] & 0x07;
+    H265LazyNalUnit::ptr lazyNal;
+    if (nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT || nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT ||
+        nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_PPS_NUT ||
+        !NalUnitTypeEnabled(nal_unit_type)
+    )
+    {
+        // Hint : parameter sets are deserialized up front, later NAL units depend on them,
+        //        disabled NAL unit types only carry the header
+        lazyNal = std::make_shared<H265LazyNalUnit>(data, size, nullptr);
+        lazyNal->_nal = MakeNalSyntax();
+        lazyNal->_res = DeserializeNalSyntax(data, size, lazyNal->_nal);
+        lazyNal->_deserialized = true;
+    }
+    else
+    {
+        if (!_lazyContex)
+        {
+            _lazyContex = std::make_shared<H265ContextSyntax>(*_contex);
+        }
+        lazyNal = std::make_shared<H265LazyNalUnit>(data, size, _lazyContex);
+        lazyNal->_nal = MakeNalSyntax();
+    }
+    lazyNal->nal_unit_type = nal_unit_type;
+    lazyNal->nuh_layer_id = nuh_layer_id;
+    lazyNal->nuh_temporal_id_plus1 = nuh_temporal_id_plus1;
+    lazyNal->_nalUnitTypeMask = _nalUnitTypeMask;
+    _arena = std::move(arena);
+    return lazyNal;
+}
+
+H265ContextSyntax::ptr H265Deserialize::GetContext()
+{
+    return _contex;
+}
+
+void H265Deserialize::SetContext(H265ContextSyntax::ptr contex)
+{
+    _contex = contex;
+    _lazyContex = nullptr;
+}
+
+bool H265Deserialize::ParameterSetChanged()
+{
+    return _parameterSetChanged;
+}
+
+void H265Deserialize::SetParameterSetStore(H265ParameterSetStore::ptr store)
+{
+    _parameterSetStore = store;
+}
+
+void H265Deserialize::SetArena(H26xArena::ptr arena)
+{
+    _arena = arena;
+}
+
+void H265Deserialize::SetSyntaxPool(H265SyntaxPool::ptr pool)
+{
+    _pool = pool;
+}
+
+void H265Deserialize::SetNalUnitTypeMask(uint64_t mask)
+{
+    _nalUnitTypeMask = mask;
+}
+
+bool H265Deserialize::NalUnitTypeEnabled(uint8_t nal_unit_type)
+{
+    return (_nalUnitTypeMask >> nal_unit_type) & 0x01;
+}
+
+bool H265Deserialize::ReuseParameterSet(const uint8_t* data, size_t size, uint64_t hash, H265NalSyntax::ptr nal)
+{
+    uint8_t nal_unit_type = (data[0] >> 1) & 0x3F;
+    std::unordered_map<int32_t, H26xParameterSetData::ptr>& dataSet = nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT ? _contex->vpsData :
+                                                                      nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT ? _contex->spsData : _contex->ppsData;
+    for (auto& psData : dataSet)
+    {
+        if (!psData.second->Equal(data, size, hash))
+        {
+            continue;
+        }
+        nal->header = MakeSyntax<H265NalUnitHeaderSyntax>();
+        nal->header->forbidden_zero_bit = 0;
+        nal->header->nal_unit_type = nal_unit_type;
+        nal->header->nuh_layer_id = ((data[0] & 0x01) << 5) | (data[1] >> 3);
+        nal->header->nuh_temporal_id_plus1 = data[1] & 0x07;
+        if (nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT)
+        {
+            nal->vps = _contex->vpsSet[psData.first];
+        }
+        else if (nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT)
+        {
+            nal->sps = _contex->spsSet[psData.first];
+        }
+        else
+        {
+            nal->pps = _contex->ppsSet[psData.first];
+        }
+        _parameterSetChanged = false;
+        return true;
+    }
+    return false;
+}
+
+bool H265Deserialize::FindParameterSet(const uint8_t* data, size_t size, uint64_t hash, H265NalSyntax::ptr nal)
+{
+    uint8_t nal_unit_type = (data[0] >> 1) & 0x3F;
+    H26xParameterSetData::ptr psData;
+    if (nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT)
+    {
+        H265VPSSyntax::ptr vps = _parameterSetStore->vpsTable.Find(data, size, hash, nullptr, psData);
+        if (!vps)
+        {
+            return false;
+        }
+        nal->vps = vps;
+        StoreVps(vps);
+        _contex->vpsData[vps->vps_video_parameter_set_id] = psData;
+    }
+    else if (nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT)
+    {
+        auto dependencyOf = [this](const H265SpsSyntax::ptr& sps) -> std::shared_ptr<void>
+        {
+            auto it = _contex->vpsSet.find(sps->sps_video_parameter_set_id);
+            return it != _contex->vpsSet.end() ? it->second : nullptr;
+        };
+        H265SpsSyntax::ptr sps = _parameterSetStore->spsTable.Find(data, size, hash, dependencyOf, psData);
+        if (!sps)
+        {
+            return false;
+        }
+        nal->sps = sps;
+        StoreSps(sps);
+        _contex->spsData[sps->sps_seq_parameter_set_id] = psData;
+    }
+    else
+    {
+        auto dependencyOf = [this](const H265PpsSyntax::ptr& pps) -> std::shared_ptr<void>
+        {
+            auto it = _contex->spsSet.find(pps->pps_seq_parameter_set_id);
+            return it != _contex->spsSet.end() ? it->second : nullptr;
+        };
+        H265PpsSyntax::ptr pps = _parameterSetStore->ppsTable.Find(data, size, hash, dependencyOf, psData);
+        if (!pps)
+        {
+            return false;
+        }
+        nal->pps = pps;
+        StorePps(pps);
+        _contex->ppsData[pps->pps_pic_parameter_set_id] = psData;
+    }
+    nal->header = MakeSyntax<H265NalUnitHeaderSyntax>();
+    nal->header->forbidden_zero_bit = 0;
+    nal->header->nal_unit_type = nal_unit_type;
+    nal->header->nuh_layer_id = ((data[0] & 0x01) << 5) | (data[1] >> 3);
+    nal->header->nuh_temporal_id_plus1 = data[1] & 0x07;
+    return true;
+}
+
+void H265Deserialize::InternParameterSet(const uint8_t* data, size_t size, uint64_t hash, H265NalSyntax::ptr nal)
+{
+    H26xParameterSetData::ptr psData = std::make_shared<H26xParameterSetData>(data, size, hash);
+    if (nal->header->nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT)
+    {
+        if (_parameterSetStore)
+        {
+            H265VPSSyntax::ptr vps = _parameterSetStore->vpsTable.Intern(psData, nal->vps, nullptr);
+            if (vps != nal->vps)
+            {
+                nal->vps = vps;
+                StoreVps(vps);
+            }
+        }
+        _contex->vpsData[nal->vps->vps_video_parameter_set_id] = psData;
+    }
+    else if (nal->header->nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT)
+    {
+        if (_parameterSetStore)
+        {
+            H265SpsSyntax::ptr sps = _parameterSetStore->spsTable.Intern(psData, nal->sps, _contex->vpsSet[nal->sps->sps_video_parameter_set_id]);
+            if (sps != nal->sps)
+            {
+                nal->sps = sps;
+                StoreSps(sps);
+            }
+        }
+        _contex->spsData[nal->sps->sps_seq_parameter_set_id] = psData;
+    }
+    else
+    {
+        if (_parameterSetStore)
+        {
+            H265PpsSyntax::ptr pps = _parameterSetStore->ppsTable.Intern(psData, nal->pps, _contex->spsSet[nal->pps->pps_seq_parameter_set_id]);
+            if (pps != nal->pps)
+            {
+                nal->pps = pps;
+                StorePps(pps);
+            }
+        }
+        _contex->ppsData[nal->pps->pps_pic_parameter_set_id] = psData;
+    }
+}
+
+void H265Deserialize::StoreVps(H265VPSSyntax::ptr vps)
+{
+    _contex->vpsSet[vps->vps_video_parameter_set_id] = vps;
+    // Hint : SPS are deserialized against their VPS, those referring to this one are deserialized again
+    //        (and then their PPS), see also ParameterSetChanged()
+    _contex->vpsData.erase(vps->vps_video_parameter_set_id);
+    for (auto it = _contex->spsData.begin(); it != _contex->spsData.end();)
+    {
+        auto sps = _contex->spsSet.find(it->first);
+        if (sps == _contex->spsSet.end() || sps->second->sps_video_parameter_set_id == vps->vps_video_parameter_set_id)
+        {
+            it = _contex->spsData.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+    _parameterSetChanged = true;
+    _lazyContex = nullptr;
+}
+
+void H265Deserialize::StoreSps(H265SpsSyntax::ptr sps)
+{
+    _contex->spsSet[sps->sps_seq_parameter_set_id] = sps;
+    // Hint : PPS are deserialized against their SPS, those referring to this one are deserialized again,
+    //        see also ParameterSetChanged()
+    _contex->spsData.erase(sps->sps_seq_parameter_set_id);
+    for (auto it = _contex->ppsData.begin(); it != _contex->ppsData.end();)
+    {
+        auto pps = _contex->ppsSet.find(it->first);
+        if (pps == _contex->ppsSet.end() || pps->second->pps_seq_parameter_set_id == sps->sps_seq_parameter_set_id)
+        {
+            it = _contex->ppsData.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+    _parameterSetChanged = true;
+    _lazyContex = nullptr;
+}
+
+void H265Deserialize::StorePps(H265PpsSyntax::ptr pps)
+{
+    _contex->ppsSet[pps->pps_pic_parameter_set_id] = pps;
+    _contex->ppsData.erase(pps->pps_pic_parameter_set_id);
+    _parameterSetChanged = true;
+    _lazyContex = nullptr;
+}
+
+H265NalSyntax::ptr H265Deserialize::MakeNalSyntax()
+{
+    return _pool ? _pool->AcquireNalSyntax() : H26xMakeShared<H265NalSyntax>(_arena.get());
+}
+
+void H265Deserialize::SetNalUnitCallback(const NalUnitCallback& callback)
+{
+    _nalUnitCallback = callback;
+}
+
+void H265Deserialize::Feed(const uint8_t* data, size_t size)
+{
+    if (!_feeder)
+    {
+        _feeder = std::make_shared<H26xByteStreamFeeder>([this](const uint8_t* data, size_t size) -> void
+        {
+            if (size && !NalUnitTypeEnabled((data[0] >> 1) & 0x3F))
+            {
+                return;
+            }
+            H265NalSyntax::ptr nal = MakeNalSyntax();
+            bool res = DeserializeNalSyntax(data, size, nal);
+            if (_nalUnitCallback)
+            {
+                _nalUnitCallback(res, nal);
+            }
+        });
+    }
+    _feeder->Feed(data, size);
+}
+
+void H265Deserialize::Flush()
+{
+    if (_feeder)
+    {
+        _feeder->Flush();
+    }
+}
+
+bool H265Deserialize::DeserializeDecoderConfigurationRecord(const uint8_t* data, size_t size, H265DecoderConfigurationRecordSyntax::ptr record)
+{
+    // See also : ISO 14496/15(2019) - 8.3.3.1.2 Syntax
+    // Hint : the record is not escaped, its NAL units are escaped on their own
+    H26xBinaryReader::ptr br = std::make_shared<H26xBinaryReader>(data, size, false);
+    MMP_H26X_TRY
+    {
+        br->U(8, record->configurationVersion);
+        br->U(2, record->general_profile_space);
+        br->U(1, record->general_tier_flag);
+        br->U(5, record->general_profile_idc);
+        br->U(32, record->general_profile_compatibility_flags);
+        br->U(48, record->general_constraint_indicator_flags);
+        br->U(8, record->general_level_idc);
+        br->Skip(4); // reserved
+        br->U(12, record->min_spatial_segmentation_idc);
+        br->Skip(6); // reserved
+        br->U(2, record->parallelismType);
+        br->Skip(6); // reserved
+        br->U(2, record->chromaFormat);
+        br->Skip(5); // reserved
+        br->U(3, record->bitDepthLumaMinus8);
+        br->Skip(5); // reserved
+        br->U(3, record->bitDepthChromaMinus8);
+        br->U(16, record->avgFrameRate);
+        br->U(2, record->constantFrameRate);
+        br->U(3, record->numTemporalLayers);
+        br->U(1, record->temporalIdNested);
+        br->U(2, record->lengthSizeMinusOne);
+        MPP_H26X_SYNTAXT_STRICT_CHECK(record->lengthSizeMinusOne != 2, "[hvcC] lengthSizeMinusOne out of range", return false);
+        br->U(8, record->numOfArrays);
+        for (uint8_t j=0; j<record->numOfArrays; j++)
+        {
+            H265DecoderConfigurationRecordArraySyntax::ptr array = std::make_shared<H265DecoderConfigurationRecordArraySyntax>();
+            br->U(1, array->array_completeness);
+            br->Skip(1); // reserved
+            br->U(6, array->NAL_unit_type);
+            br->U(16, array->numNalus);
+            for (uint16_t i=0; i<array->numNalus; i++)
+            {
+                uint16_t nalUnitLength = 0;
+                br->U(16, nalUnitLength);
+                size_t offset = br->CurBits() / 8;
+                // Hint : the record comes from the container (MP4, MKV), length is checked against the record itself
+                if (br->Error() || offset > size || nalUnitLength > size - offset)
+                {
+                    H26x_LOG_ERROR << "[H265] truncated hvcC NAL unit, length is " << nalUnitLength << ", but only " << (offset > size ? 0 : size - offset) << " bytes left" << H26x_LOG_TERMINATOR;
+                    return false;
+                }
+                br->Skip(nalUnitLength * 8);
+                H265NalSyntax::ptr nal = MakeNalSyntax();
+                if (!DeserializeNalSyntax(data + offset, nalUnitLength, nal))
+                {
+                    return false;
+                }
+                array->nalUnits.push_back(nal);
+            }
+            record->arrays.push_back(array);
+        }
+        return !br->Error();
+    }
+    MMP_H26X_CATCH(...)
+    {
+        return false;
+    }
+    return false;
+}
+
+bool H265Deserialize::DeserializeLengthPrefixedNalUnits(const uint8_t* data, size_t size, uint8_t lengthSize, std::vector<H265NalSyntax::ptr>& nals)
+{
+    if (lengthSize != 1 && lengthSize != 2 && lengthSize != 4)
+    {
+        H26x_LOG_ERROR << "[H265] unsupport length size " << (uint32_t)lengthSize << H26x_LOG_TERMINATOR;
+        return false;
+    }
+    size_t pos = 0;
+    while (pos < size)
+    {
+        if (size - pos < lengthSize)
+        {
+            H26x_LOG_ERROR << "[H265] truncated length prefix" << H26x_LOG_TERMINATOR;
+            return false;
+        }
+        size_t length = 0;
+        for (uint8_t i=0; i<lengthSize; i++)
+        {
+            length = (length << 8) | data[pos + i];
+        }
+        pos += lengthSize;
+        if (size - pos < length)
+        {
+            H26x_LOG_ERROR << "[H265] truncated NAL unit, length is " << length << ", but only " << size - pos << " bytes left" << H26x_LOG_TERMINATOR;
+            return false;
+        }
+        if (length && !NalUnitTypeEnabled((data[pos] >> 1) & 0x3F))
+        {
+            pos += length;
+            continue;
+        }
+        H265NalSyntax::ptr nal = MakeNalSyntax();
+        bool res = DeserializeNalSyntax(data + pos, length, nal);
+        nals.push_back(nal);
+        if (!res)
+        {
+            return false;
+        }
+        pos += length;
+    }
+    return true;
 }
 
 bool H265Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H265NalSyntax::ptr nal)
 {
     // See also : ITU-T H.265 (2021) - B.2.1 Byte stream NAL unit syntax
-    try
+    MMP_H26X_TRY
     {
         uint32_t next_24_bits = 0;
-        br->U(24, next_24_bits, true);
+        next_24_bits = br->ShowBits(24);
         while (next_24_bits != 0x000001)
         {
+            if (br->Error()) // eof (MMP_H26X_NO_EXCEPTIONS)
+            {
+                return true;
+            }
             if ((next_24_bits & 0xFFFF) == 0)
             {
-                br->Skip(8);
+                br->SkipBits(8);
             }
             else if ((next_24_bits & 0xFF) == 0)
             {
-                br->Skip(16);
+                br->SkipBits(16);
             }
             else
             {
-                br->Skip(32);
+                br->SkipBits(24); // Hint : the next start code may begin right after the third byte
             }
-            br->U(24, next_24_bits, true);
+            next_24_bits = br->ShowBits(24);
         }
-        br->Skip(24); // start_code_prefix_one_3bytes /* equal to 0x000001 */
+        br->SkipBits(24); // start_code_prefix_one_3bytes /* equal to 0x000001 */
         if (!DeserializeNalSyntax(br, nal))
         {
             return false;
         }
         while (br->more_data_in_byte_stream())
         {
-            br->U(24, next_24_bits, true);
+            next_24_bits = br->ShowBits(24);
             if (next_24_bits != 0x000001)
             {
                 if ((next_24_bits & 0xFFFF) == 0)
                 {
-                    br->Skip(8);
+                    br->SkipBits(8);
                 }
                 else if ((next_24_bits & 0xFF) == 0)
                 {
-                    br->Skip(16);
+                    br->SkipBits(16);
                 }
                 else
                 {
-                    br->Skip(32);
+                    br->SkipBits(24); // Hint : the next start code may begin right after the third byte
                 }
             }
             else
@@ -72,11 +518,11 @@ bool H265Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H26
         }
         return true;
     }
-    catch (const std::out_of_range& /* eof */)
+    MMP_H26X_CATCH(const std::out_of_range& /* eof */)
     {
         return true;
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -85,15 +531,20 @@ bool H265Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H26
 bool H265Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H265NalSyntax::ptr nal)
 {
     // See also : ITU-T H.265 (2021) - B.2.1 Byte stream NAL unit syntax
-    try
+    MMP_H26X_TRY
     {
         br->BeginNalUnit();
-        nal->header = std::make_shared<H265NalUnitHeaderSyntax>();
+        nal->header = MakeSyntax<H265NalUnitHeaderSyntax>();
         if (!DeserializeNalHeaderSyntax(br, nal->header))
         {
             assert(false);
             return false;
         }
+        if (!NalUnitTypeEnabled(nal->header->nal_unit_type))
+        {
+            br->EndNalUnit();
+            return !br->Error();
+        }
         switch (nal->header->nal_unit_type) 
         {
             case H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT:
@@ -143,7 +594,7 @@ bool H265Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H265NalSynt
             case H265NaluType::MMP_H265_NALU_TYPE_RASL_N:
             case H265NaluType::MMP_H265_NALU_TYPE_RASL_R:
             {
-                nal->slice = std::make_shared<H265SliceHeaderSyntax>();
+                nal->slice = MakeSyntax<H265SliceHeaderSyntax>();
                 if (!DeserializeSliceHeaderSyntax(br, nal->header, nal->slice))
                 {
                     assert(false);
@@ -156,30 +607,69 @@ bool H265Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H265NalSynt
                 break;
         }
         br->EndNalUnit();
-        return true;
+        return !br->Error() || br->Eof();
     }
-    catch (const std::out_of_range& /* eof */)
+    MMP_H26X_CATCH(const std::out_of_range& /* eof */)
     {
         return true;
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     } 
 }
 
+bool H265Deserialize::DeserializeNalSyntax(const uint8_t* data, size_t size, H265NalSyntax::ptr nal)
+{
+    // Hint : parameter sets are repeated before every IRAP picture by most broadcast sources,
+    //        byte identical ones are looked up by hash instead of deserialized again
+    uint8_t nal_unit_type = size >= 2 ? (data[0] >> 1) & 0x3F : 0xFF;
+    bool isParameterSet = (nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT || nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT ||
+                           nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_PPS_NUT) && NalUnitTypeEnabled(nal_unit_type);
+    uint64_t hash = 0;
+    if (isParameterSet)
+    {
+        hash = H26xHash(data, size);
+        if (ReuseParameterSet(data, size, hash, nal))
+        {
+            return true;
+        }
+        // Hint : then among parameter sets deserialized by other streams, see also SetParameterSetStore()
+        if (_parameterSetStore && FindParameterSet(data, size, hash, nal))
+        {
+            return true;
+        }
+    }
+    // Hint : one reader is kept and rebound for every NAL unit, no per-byte indirection and no stream seeking
+    if (!_spanReader)
+    {
+        _spanReader = std::make_shared<H26xBinaryReader>(data, size);
+    }
+    else
+    {
+        _spanReader->Reset(data, size);
+    }
+    _spanReader->SetNalUnitSize(size);
+    bool res = DeserializeNalSyntax(_spanReader, nal);
+    if (res && isParameterSet)
+    {
+        InternParameterSet(data, size, hash, nal);
+    }
+    return res;
+}
+
 bool H265Deserialize::DeserializeNalHeaderSyntax(H26xBinaryReader::ptr br, H265NalUnitHeaderSyntax::ptr nalHeader)
 {
     // See also : ITU-T H.265 (2021) - 7.3.1.2 NAL unit header syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, nalHeader->forbidden_zero_bit);
         br->U(6, nalHeader->nal_unit_type);
         br->U(6, nalHeader->nuh_layer_id);
         br->U(3, nalHeader->nuh_temporal_id_plus1);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     } 
@@ -188,7 +678,7 @@ bool H265Deserialize::DeserializeNalHeaderSyntax(H26xBinaryReader::ptr br, H265N
 bool H265Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H265PpsSyntax::ptr pps)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.3.1 General picture parameter set RBSP syntax
-    try
+    MMP_H26X_TRY
     {
         br->UE(pps->pps_pic_parameter_set_id);
         {
@@ -349,10 +839,10 @@ bool H265Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H265PpsSynt
             }
         }
         br->rbsp_trailing_bits();
-        _contex->ppsSet[pps->pps_pic_parameter_set_id] = pps;
-        return true;
+        StorePps(pps);
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -361,7 +851,7 @@ bool H265Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H265PpsSynt
 bool H265Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps)
 {
     // See also : 7.3.2.2.1 General sequence parameter set RBSP syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(4, sps->sps_video_parameter_set_id);
         if (_contex->vpsSet.count(sps->sps_video_parameter_set_id) == 0)
@@ -549,10 +1039,10 @@ bool H265Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H265SpsSynt
             }
         }
         br->rbsp_trailing_bits();
-        _contex->spsSet[sps->sps_seq_parameter_set_id] = sps;
-        return true;
+        StoreSps(sps);
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -561,7 +1051,7 @@ bool H265Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H265SpsSynt
 bool H265Deserialize::DeserializeVPSSyntax(H26xBinaryReader::ptr br, H265VPSSyntax::ptr vps)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.1 Video parameter set RBSP syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(4, vps->vps_video_parameter_set_id);
         br->U(1, vps->vps_base_layer_internal_flag);
@@ -640,10 +1130,10 @@ bool H265Deserialize::DeserializeVPSSyntax(H26xBinaryReader::ptr br, H265VPSSynt
             }
         }
         br->rbsp_trailing_bits();
-        _contex->vpsSet[vps->vps_video_parameter_set_id] = vps;
-        return true;
+        StoreVps(vps);
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -652,7 +1142,7 @@ bool H265Deserialize::DeserializeVPSSyntax(H26xBinaryReader::ptr br, H265VPSSynt
 bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H265NalUnitHeaderSyntax::ptr nal,  H265SliceHeaderSyntax::ptr slice)
 {
     // See also : ITU-T H.265 (2021) - 7.3.6.1 General slice segment header syntax
-    try
+    MMP_H26X_TRY
     {
         H265SpsSyntax::ptr sps;
         H265PpsSyntax::ptr pps;
@@ -663,18 +1153,21 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
             br->U(1, slice->no_output_of_prior_pics_flag);
         }
         br->UE(slice->slice_pic_parameter_set_id);
-        if (_contex->ppsSet.count(slice->slice_pic_parameter_set_id) == 0)
+        // Hint : lookups only, the context may be shared by lazy NAL units deserialized concurrently
+        auto ppsIt = _contex->ppsSet.find(slice->slice_pic_parameter_set_id);
+        if (ppsIt == _contex->ppsSet.end())
         {
             assert(false);
             return false;
         }
-        pps = _contex->ppsSet[slice->slice_pic_parameter_set_id];
-        if (_contex->spsSet.count(pps->pps_seq_parameter_set_id) == 0)
+        pps = ppsIt->second;
+        auto spsIt = _contex->spsSet.find(pps->pps_seq_parameter_set_id);
+        if (spsIt == _contex->spsSet.end())
         {
             assert(false);
             return false;
         }
-        sps = _contex->spsSet[pps->pps_seq_parameter_set_id];
+        sps = spsIt->second;
         if (!slice->first_slice_segment_in_pic_flag)
         {
             if (pps->dependent_slice_segments_enabled_flag)
@@ -705,7 +1198,7 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
                 br->U(1, slice->short_term_ref_pic_set_sps_flag);
                 if (!slice->short_term_ref_pic_set_sps_flag)
                 {
-                    slice->stps = std::make_shared<H265StRefPicSetSyntax>();
+                    slice->stps = MakeSyntax<H265StRefPicSetSyntax>();
                     if (!DeserializeStRefPicSetSyntax(br, sps, sps->num_short_term_ref_pic_sets, slice->stps))
                     {
                         assert(false);
@@ -775,7 +1268,7 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
                         uint32_t NumPicTotalCurr = 0; // TODO (7-57)
                         if (pps->lists_modification_present_flag && NumPicTotalCurr>1)
                         {
-                            slice->rplm = std::make_shared<H265RefPicListsModificationSyntax>();
+                            slice->rplm = MakeSyntax<H265RefPicListsModificationSyntax>();
                             if (!DeserializeRefPicListsModificationSyntax(br, slice, slice->rplm))
                             {
                                 assert(false);
@@ -807,7 +1300,7 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
                             (pps->weighted_pred_flag && slice->slice_type == H265SliceType::MMP_H265_B_SLICE)
                         )
                         {
-                            slice->pwt = std::make_shared<H265PredWeightTableSyntax>();
+                            slice->pwt = MakeSyntax<H265PredWeightTableSyntax>();
                             if (!DeserializePredWeightTableSyntax(br, sps, slice, slice->pwt))
                             {
                                 assert(false);
@@ -878,9 +1371,9 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
                 
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -889,7 +1382,7 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
 bool H265Deserialize::DeserializePps3dSyntax(H26xBinaryReader::ptr br, H265PpsSyntax::ptr pps, H265Pps3dSyntax::ptr pps3d)
 {
     // See also : ITU-T H.265 (2021) - I.7.3.2.3.7 Picture parameter set 3D extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, pps3d->dlts_present_flag);
         if (pps3d->dlts_present_flag)
@@ -932,9 +1425,9 @@ bool H265Deserialize::DeserializePps3dSyntax(H26xBinaryReader::ptr br, H265PpsSy
                 }
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -943,7 +1436,7 @@ bool H265Deserialize::DeserializePps3dSyntax(H26xBinaryReader::ptr br, H265PpsSy
 bool H265Deserialize::DeserializePpsRangeSyntax(H26xBinaryReader::ptr br, H265PpsSyntax::ptr pps, H265PpsRangeSyntax::ptr ppsRange)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.3.2 Picture parameter set range extension syntax
-    try
+    MMP_H26X_TRY
     {
         if (pps->transform_skip_enabled_flag)
         {
@@ -965,9 +1458,9 @@ bool H265Deserialize::DeserializePpsRangeSyntax(H26xBinaryReader::ptr br, H265Pp
         }
         br->UE(ppsRange->log2_sao_offset_scale_luma); 
         br->UE(ppsRange->log2_sao_offset_scale_chroma); 
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }   
@@ -976,7 +1469,7 @@ bool H265Deserialize::DeserializePpsRangeSyntax(H26xBinaryReader::ptr br, H265Pp
 bool H265Deserialize::DeserializePpsSccSyntax(H26xBinaryReader::ptr br, H265PpsSccSyntax::ptr ppsScc)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.3.3 Picture parameter set screen content coding extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, ppsScc->pps_curr_pic_ref_enabled_flag);
         br->U(1, ppsScc->residual_adaptive_colour_transform_enabled_flag);
@@ -1025,9 +1518,9 @@ bool H265Deserialize::DeserializePpsSccSyntax(H26xBinaryReader::ptr br, H265PpsS
                 }
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }  
@@ -1036,7 +1529,7 @@ bool H265Deserialize::DeserializePpsSccSyntax(H26xBinaryReader::ptr br, H265PpsS
 bool H265Deserialize::DeserializeSpsRangeSyntax(H26xBinaryReader::ptr br, H265SpsRangeSyntax::ptr spsRange)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.2.2 Sequence parameter set range extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, spsRange->transform_skip_rotation_enabled_flag);
         br->U(1, spsRange->transform_skip_context_enabled_flag);
@@ -1046,9 +1539,9 @@ bool H265Deserialize::DeserializeSpsRangeSyntax(H26xBinaryReader::ptr br, H265Sp
         br->U(1, spsRange->high_precision_offsets_enabled_flag);
         br->U(1, spsRange->persistent_rice_adaptation_enabled_flag);
         br->U(1, spsRange->cabac_bypass_alignment_enabled_flag);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1057,7 +1550,7 @@ bool H265Deserialize::DeserializeSpsRangeSyntax(H26xBinaryReader::ptr br, H265Sp
 bool H265Deserialize::DeserializeSps3DSyntax(H26xBinaryReader::ptr br, H265Sps3DSyntax::ptr sps3d)
 {
     // See also : ITU-T H.265 (2021) - I.7.3.2.2.5 Sequence parameter set 3D extension syntax
-    try
+    MMP_H26X_TRY
     {
         for (uint32_t d=0; d<=1; d++)
         {
@@ -1082,9 +1575,9 @@ bool H265Deserialize::DeserializeSps3DSyntax(H26xBinaryReader::ptr br, H265Sps3D
                 br->U(1, sps3d->skip_intra_enabled_flag);
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1093,7 +1586,7 @@ bool H265Deserialize::DeserializeSps3DSyntax(H26xBinaryReader::ptr br, H265Sps3D
 bool H265Deserialize::DeserializeSpsSccSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265SpsSccSyntax::ptr spsScc)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.2.3 Sequence parameter set screen content coding extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, spsScc->sps_curr_pic_ref_enabled_flag);
         br->U(1, spsScc->palette_mode_enabled_flag);
@@ -1119,9 +1612,9 @@ bool H265Deserialize::DeserializeSpsSccSyntax(H26xBinaryReader::ptr br, H265SpsS
         }
         br->U(2, spsScc->motion_vector_resolution_control_idc);
         br->U(1, spsScc->intra_boundary_filtering_disabled_flag);
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1130,7 +1623,7 @@ bool H265Deserialize::DeserializeSpsSccSyntax(H26xBinaryReader::ptr br, H265SpsS
 bool H265Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265VuiSyntax::ptr vui)
 {
     // See also : ITU-T H.265 (2021) - E.2.1 VUI parameters syntax
-    try
+    MMP_H26X_TRY
     {
         constexpr uint8_t EXTENDED_SAR = 255;
 
@@ -1252,9 +1745,9 @@ bool H265Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H265SpsSynt
                 br->UE(vui->log2_max_mv_length_vertical);
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     } 
@@ -1263,7 +1756,7 @@ bool H265Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H265SpsSynt
 bool H265Deserialize::DeserializeRefPicListsModificationSyntax(H26xBinaryReader::ptr br, H265SliceHeaderSyntax::ptr slice, H265RefPicListsModificationSyntax::ptr rplm)
 {
     // See also : ITU-T H.265 (2021) - 7.3.6.2 Reference picture list modification syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, rplm->ref_pic_list_modification_flag_l0);
         if (rplm->ref_pic_list_modification_flag_l0)
@@ -1286,9 +1779,9 @@ bool H265Deserialize::DeserializeRefPicListsModificationSyntax(H26xBinaryReader:
                 }
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1297,12 +1790,12 @@ bool H265Deserialize::DeserializeRefPicListsModificationSyntax(H26xBinaryReader:
 bool H265Deserialize::DeserializePredWeightTableSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265SliceHeaderSyntax::ptr slice, H265PredWeightTableSyntax::ptr pwt)
 {
     // See also : ITU-T H.265 (2021) - 7.3.6.3 Weighted prediction parameters syntax
-    try
+    MMP_H26X_TRY
     {
         // TODO
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1311,7 +1804,7 @@ bool H265Deserialize::DeserializePredWeightTableSyntax(H26xBinaryReader::ptr br,
 bool H265Deserialize::DeserializeSeiDecodedPictureHash(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265SeiDecodedPictureHashSyntax::ptr dph)
 {
     // See also : ITU-T H.265 (2021) - D.2.20 Decoded picture hash SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(8, dph->hash_type);
         if (dph->hash_type == 0)
@@ -1345,9 +1838,9 @@ bool H265Deserialize::DeserializeSeiDecodedPictureHash(H26xBinaryReader::ptr br,
                 br->U(32, dph->picture_checksum[cIdx]);
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1356,7 +1849,7 @@ bool H265Deserialize::DeserializeSeiDecodedPictureHash(H26xBinaryReader::ptr br,
 bool H265Deserialize::DeserializeSeiPicTimingSyntax(H26xBinaryReader::ptr br, H265VuiSyntax::ptr vui, H265HrdSyntax::ptr hrd, H264SeiPicTimingSyntax::ptr pt)
 {
     // See also : ITU-T H.265 (2021) - D.2.3 Picture timing SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         if (vui->frame_field_info_present_flag)
         {
@@ -1395,9 +1888,9 @@ bool H265Deserialize::DeserializeSeiPicTimingSyntax(H26xBinaryReader::ptr br, H2
                 }
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1406,7 +1899,7 @@ bool H265Deserialize::DeserializeSeiPicTimingSyntax(H26xBinaryReader::ptr br, H2
 bool H265Deserialize::DeserializeSeiActiveParameterSetsSyntax(H26xBinaryReader::ptr br, H265VPSSyntax::ptr vps, H265SeiActiveParameterSetsSyntax::ptr aps)
 {
     // See also : ITU-T H.265 (2021) - D.2.21 Active parameter sets SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(4, aps->active_video_parameter_set_id);
         br->U(1, aps->self_contained_cvs_flag);
@@ -1423,9 +1916,9 @@ bool H265Deserialize::DeserializeSeiActiveParameterSetsSyntax(H26xBinaryReader::
         {
             br->UE(aps->layer_sps_idx[i]);
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1434,7 +1927,7 @@ bool H265Deserialize::DeserializeSeiActiveParameterSetsSyntax(H26xBinaryReader::
 bool H265Deserialize::DeserializeSeiActiveParameterSetsSyntax(H26xBinaryReader::ptr br, H265SeiTimeCodeSyntax::ptr tc)
 {
     // See also : ITU-T H.265 (2021) - D.2.27 Time code SEI message syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(2, tc->num_clock_ts);
         tc->clock_timestamp_flag.resize(tc->num_clock_ts + 1);
@@ -1494,9 +1987,9 @@ bool H265Deserialize::DeserializeSeiActiveParameterSetsSyntax(H26xBinaryReader::
                 br->I(tc->time_offset_length[i], tc->time_offset_value[i]);
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1505,7 +1998,7 @@ bool H265Deserialize::DeserializeSeiActiveParameterSetsSyntax(H26xBinaryReader::
 bool H265Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, uint8_t commonInfPresentFlag, uint32_t maxNumSubLayersMinus, H265HrdSyntax::ptr hrd)
 {
     // See also : ITU-T H.265 (2021) - E.2.2 HRD parameters syntax
-    try
+    MMP_H26X_TRY
     {
         if (commonInfPresentFlag)
         {
@@ -1579,9 +2072,9 @@ bool H265Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, uint8_t com
                 }
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1590,7 +2083,7 @@ bool H265Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, uint8_t com
 bool H265Deserialize::DeserializeSubLayerHrdSyntax(H26xBinaryReader::ptr br, uint32_t subLayerId, H265HrdSyntax::ptr hrd, H265SubLayerHrdSyntax::ptr slHrd)
 {
     // See also : ITU-T H.265 (2021) - E.2.3 Sub-layer HRD parameters syntax
-    try
+    MMP_H26X_TRY
     {
         uint32_t CpbCnt = hrd->cpb_cnt_minus1[subLayerId] + 1;
         slHrd->bit_rate_value_minus1.resize(CpbCnt);
@@ -1609,9 +2102,9 @@ bool H265Deserialize::DeserializeSubLayerHrdSyntax(H26xBinaryReader::ptr br, uin
             }
             br->U(1, slHrd->cbr_flag[i]);
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1620,7 +2113,7 @@ bool H265Deserialize::DeserializeSubLayerHrdSyntax(H26xBinaryReader::ptr br, uin
 bool H265Deserialize::DeserializePTLSyntax(H26xBinaryReader::ptr br, uint8_t profilePresentFlag, uint32_t maxNumSubLayersMinus1, H265PTLSyntax::ptr ptl)
 {
     // See also : ITU-T H.265 (2021) - 7.3.3 Profile, tier and level syntax
-    try
+    MMP_H26X_TRY
     {
         if (profilePresentFlag)
         {
@@ -1838,9 +2331,9 @@ bool H265Deserialize::DeserializePTLSyntax(H26xBinaryReader::ptr br, uint8_t pro
                 }
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1849,19 +2342,11 @@ bool H265Deserialize::DeserializePTLSyntax(H26xBinaryReader::ptr br, uint8_t pro
 bool H265Deserialize::DeserializeScalingListDataSyntax(H26xBinaryReader::ptr br, H265ScalingListDataSyntax::ptr sld)
 {
     // See also : ITU-T H.265 (2021) - 7.3.4 Scaling list data syntax
-    try
+    MMP_H26X_TRY
     {
         int32_t scaling_list_delta_coef = 0;
-        sld->scaling_list_pred_mode_flag.resize(4);
-        sld->scaling_list_pred_matrix_id_delta.resize(4);
-        sld->scaling_list_dc_coef_minus8.resize(4);
-        sld->ScalingList.resize(4);
         for (uint32_t sizeId = 0; sizeId < 4; sizeId++)
         {
-            sld->scaling_list_pred_mode_flag[sizeId].resize(6);
-            sld->scaling_list_pred_matrix_id_delta[sizeId].resize(6);
-            sld->scaling_list_dc_coef_minus8[sizeId].resize(6);
-            sld->ScalingList[sizeId].resize(6);
             for (uint32_t matrixId=0; matrixId<6; matrixId+=(sizeId == 3)?3:1)
             {
                 br->U(1, sld->scaling_list_pred_mode_flag[sizeId][matrixId]);
@@ -1878,7 +2363,6 @@ bool H265Deserialize::DeserializeScalingListDataSyntax(H26xBinaryReader::ptr br,
                         br->SE(sld->scaling_list_dc_coef_minus8[sizeId-2][matrixId]);
                         nextCoef = sld->scaling_list_dc_coef_minus8[sizeId-2][matrixId] + 8;
                     }
-                    sld->ScalingList[sizeId][matrixId].resize(coefNum + 1);
                     for (uint32_t i=0; i<coefNum; i++)
                     {
                         br->SE(scaling_list_delta_coef);
@@ -1888,9 +2372,9 @@ bool H265Deserialize::DeserializeScalingListDataSyntax(H26xBinaryReader::ptr br,
                 }
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1899,7 +2383,7 @@ bool H265Deserialize::DeserializeScalingListDataSyntax(H26xBinaryReader::ptr br,
 bool H265Deserialize::DeserializeStRefPicSetSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, uint32_t stRpsIdx, H265StRefPicSetSyntax::ptr stps)
 {
     // See also : ITU-T H.265 (2021) - 7.3.7 Short-term reference picture set syntax
-    try
+    MMP_H26X_TRY
     {
         if (stRpsIdx != 0)
         {
@@ -1953,9 +2437,9 @@ bool H265Deserialize::DeserializeStRefPicSetSyntax(H26xBinaryReader::ptr br, H26
         {
             stps->NumDeltaPocs = stps->num_negative_pics + stps->num_positive_pics;
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1964,7 +2448,7 @@ bool H265Deserialize::DeserializeStRefPicSetSyntax(H26xBinaryReader::ptr br, H26
 bool H265Deserialize::DeserializeColourMappingTable(H26xBinaryReader::ptr br, H265ColourMappingTable::ptr cmt)
 {
     // See also : ITU-T H.265 (2021) - F.7.3.2.3.5 General colour mapping table syntax
-    try
+    MMP_H26X_TRY
     {
         br->UE(cmt->num_cm_ref_layers_minus1);
         cmt->cm_ref_layer_id.resize(cmt->num_cm_ref_layers_minus1 + 1);
@@ -1986,9 +2470,9 @@ bool H265Deserialize::DeserializeColourMappingTable(H26xBinaryReader::ptr br, H2
             br->SE(cmt->cm_adapt_threshold_v_delta);
         }
         // TODO : colour_mapping_octants( 0, 0, 0, 0, 1  <<  cm_octant_depth )
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -1997,7 +2481,7 @@ bool H265Deserialize::DeserializeColourMappingTable(H26xBinaryReader::ptr br, H2
 bool H265Deserialize::DeserializePpsMultilayerSyntax(H26xBinaryReader::ptr br, H265PpsMultilayerSyntax::ptr ppsMultilayer)
 {
     // See also : ITU-T H.265 (2021) - F.7.3.2.3.4 Picture parameter set multilayer extension syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(1, ppsMultilayer->poc_reset_info_present_flag);
         br->U(1, ppsMultilayer->pps_infer_scaling_list_flag);
@@ -2049,9 +2533,9 @@ bool H265Deserialize::DeserializePpsMultilayerSyntax(H26xBinaryReader::ptr br, H
                 return false;
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -2060,7 +2544,7 @@ bool H265Deserialize::DeserializePpsMultilayerSyntax(H26xBinaryReader::ptr br, H
 bool H265Deserialize::DeserializeDeltaDltSyntax(H26xBinaryReader::ptr br, H265Pps3dSyntax::ptr pps3d, H265DeltaDltSyntax::ptr dd)
 {
     // See also : ITU-T H.265 (2021) - I.7.3.2.3.8 Delta depth look-up table syntax
-    try
+    MMP_H26X_TRY
     {
         br->U(pps3d->pps_bit_depth_for_depth_layers_minus8+8, dd->num_val_delta_dlt);
         if (dd->num_val_delta_dlt > 0)
@@ -2084,9 +2568,9 @@ bool H265Deserialize::DeserializeDeltaDltSyntax(H26xBinaryReader::ptr br, H265Pp
                 }
             }
         }
-        return true;
+        return !br->Error();
     }
-    catch (...)
+    MMP_H26X_CATCH(...)
     {
         return false;
     }
@@ -11,9 +11,16 @@
 #include <cstdint>
 #include <memory>
 #include <vector>
+#include <functional>
 
 #include "H265Common.h"
+#include "H265LazyNalUnit.h"
+#include "H265SyntaxPool.h"
+#include "H265ParameterSetStore.h"
+#include "H26xArena.h"
 #include "H26xBinaryReader.h"
+#include "H26xNalSplitter.h"
+#include "H26xByteStreamFeeder.h"
 
 namespace Mmp
 {
@@ -24,6 +31,11 @@ class H265Deserialize
 {
 public:
     using ptr = std::shared_ptr<H265Deserialize>;
+    /**
+     * @param res : result of DeserializeNalSyntax
+     * @param nal : deserialized NAL unit
+     */
+    using NalUnitCallback = std::function<void(bool res, H265NalSyntax::ptr nal)>;
 public:
     H265Deserialize();
     ~H265Deserialize() = default;
@@ -33,6 +45,107 @@ public:
      */
     bool DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H265NalSyntax::ptr nal);
     bool DeserializeNalSyntax(H26xBinaryReader::ptr br, H265NalSyntax::ptr nal);
+    /**
+     * @brief deserialize one NAL unit (without start code) from contiguous memory
+     * @note  no copy is made, data must stay valid during the call
+     */
+    bool DeserializeNalSyntax(const uint8_t* data, size_t size, H265NalSyntax::ptr nal);
+    /**
+     * @brief deserialize all NAL units of a byte stream (Annex B) held in memory, such as one PES packet
+     * @param nals : deserialized NAL units are appended
+     * @note  start codes are located with H26xNalSplitter, each NAL unit is deserialized in place
+     */
+    bool DeserializeByteStream(const uint8_t* data, size_t size, std::vector<H265NalSyntax::ptr>& nals);
+    /**
+     * @brief decode the NAL unit header only, the body is deserialized on first access,
+     *        see also H265LazyNalUnit
+     * @note  1 - no copy is made, data must stay valid until the body is deserialized
+     *        2 - the current masks apply to the body, the arena is never used
+     */
+    H265LazyNalUnit::ptr DeserializeLazyNalUnit(const uint8_t* data, size_t size);
+public:
+    /**
+     * @brief parameter sets received so far
+     * @note  SetContext() takes ownership, the context is modified by later parameter sets,
+     *        see also H265ParallelDeserialize
+     */
+    H265ContextSyntax::ptr GetContext();
+    void SetContext(H265ContextSyntax::ptr contex);
+    /**
+     * @brief whether the last parameter set (VPS, SPS or PPS) deserialized changed the parameter sets in effect
+     * @note  1 - a parameter set byte identical to the one stored with the same id is not deserialized again,
+     *            the stored one is reused (nal->vps, nal->sps or nal->pps) and false is returned
+     *        2 - only NAL units deserialized from memory take the fast path, DeserializeNalSyntax()
+     *            from H26xBinaryReader always deserializes
+     *        3 - SPS and PPS are deserialized again once the parameter set they depend on has changed
+     */
+    bool ParameterSetChanged();
+    /**
+     * @brief look up and intern parameter sets in store, nullptr to disable (default)
+     * @note  1 - parameter sets deserialized by any deserializer sharing store are not deserialized again,
+     *            the context refers to the interned object, see also H265ParameterSetStore::Global()
+     *        2 - only NAL units deserialized from memory are interned, like the fast path of ParameterSetChanged()
+     */
+    void SetParameterSetStore(H265ParameterSetStore::ptr store);
+public: /* memory */
+    /**
+     * @brief carve per NAL unit syntax (NAL unit, slice segment header and their children) from arena,
+     *        nullptr for the heap (default)
+     * @note  1 - parameter sets are kept by the context, they are always on the heap
+     *        2 - syntax from arena shall be released before H26xArena::Reset(), e.g. once per NAL unit or access unit
+     *        3 - the NAL unit passed to DeserializeNalSyntax() is allocated by the caller, see also H26xMakeShared
+     */
+    void SetArena(H26xArena::ptr arena);
+    /**
+     * @brief recycle per NAL unit syntax from pool, nullptr to disable (default)
+     * @note  takes precedence over SetArena(), use H265SyntaxPool::AcquireNalSyntax() for the NAL unit
+     *        passed to DeserializeNalSyntax()
+     */
+    void SetSyntaxPool(H265SyntaxPool::ptr pool);
+    /**
+     * @brief NAL unit syntax from the syntax pool, the arena or the heap, whichever is set
+     * @note  for the NAL unit passed to DeserializeNalSyntax()
+     */
+    H265NalSyntax::ptr MakeNalSyntax();
+public: /* selective deserialization */
+    /**
+     * @brief only NAL units whose type is set in mask are deserialized (bit n for nal_unit_type n), all by default
+     * @note  1 - checked right after the NAL unit header, other NAL units are skipped without syntax parsing
+     *        2 - DeserializeByteStream(), Feed() and DeserializeLengthPrefixedNalUnits() drop them altogether,
+     *            DeserializeNalSyntax() fills the NAL unit header only
+     *        3 - slices need their parameter sets, keep VPS, SPS and PPS in mask as long as slices are
+     */
+    void SetNalUnitTypeMask(uint64_t mask);
+public: /* push mode */
+    /**
+     * @brief callback invoked for each NAL unit deserialized by Feed() or Flush(), in stream order
+     */
+    void SetNalUnitCallback(const NalUnitCallback& callback);
+    /**
+     * @brief push the next chunk of byte stream (Annex B), chunks may be of any size
+     * @note  a NAL unit is deserialized once the next start code arrives, only the unfinished
+     *        tail of data is buffered, see also H26xByteStreamFeeder
+     * @sa    ITU-T H.265 (2021) - B.2.1 Byte stream NAL unit syntax
+     */
+    void Feed(const uint8_t* data, size_t size);
+    /**
+     * @brief end of byte stream, deserialize the last NAL unit
+     */
+    void Flush();
+public: /* length prefixed (HVCC) */
+    /**
+     * @brief deserialize HEVCDecoderConfigurationRecord (hvcC box of MP4, CodecPrivate of MKV),
+     *        the VPS, SPS and PPS within are deserialized into the context as well
+     * @sa    ISO 14496/15(2019) - 8.3.3.1 HEVC decoder configuration record
+     */
+    bool DeserializeDecoderConfigurationRecord(const uint8_t* data, size_t size, H265DecoderConfigurationRecordSyntax::ptr record);
+    /**
+     * @brief deserialize NAL units each preceded by its size, such as one MP4/MKV sample
+     * @param lengthSize : size of the length prefix, 1, 2 or 4 (lengthSizeMinusOne + 1 of the decoder configuration record)
+     * @param nals : deserialized NAL units are appended
+     * @note  no start code is searched and no copy is made, each NAL unit is deserialized in place
+     */
+    bool DeserializeLengthPrefixedNalUnits(const uint8_t* data, size_t size, uint8_t lengthSize, std::vector<H265NalSyntax::ptr>& nals);
     bool DeserializeNalHeaderSyntax(H26xBinaryReader::ptr br, H265NalUnitHeaderSyntax::ptr nalHeader); 
     bool DeserializePpsSyntax(H26xBinaryReader::ptr br, H265PpsSyntax::ptr pps);
     bool DeserializeSpsSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps);
@@ -64,8 +177,30 @@ private:
     bool DeserializeColourMappingTable(H26xBinaryReader::ptr br, H265ColourMappingTable::ptr cmt);
     bool DeserializePpsMultilayerSyntax(H26xBinaryReader::ptr br, H265PpsMultilayerSyntax::ptr ppsMultilayer);
     bool DeserializeDeltaDltSyntax(H26xBinaryReader::ptr br, H265Pps3dSyntax::ptr pps3d, H265DeltaDltSyntax::ptr dd);
+private:
+    bool NalUnitTypeEnabled(uint8_t nal_unit_type);
+    bool ReuseParameterSet(const uint8_t* data, size_t size, uint64_t hash, H265NalSyntax::ptr nal);
+    bool FindParameterSet(const uint8_t* data, size_t size, uint64_t hash, H265NalSyntax::ptr nal);
+    void InternParameterSet(const uint8_t* data, size_t size, uint64_t hash, H265NalSyntax::ptr nal);
+    void StoreVps(H265VPSSyntax::ptr vps);
+    void StoreSps(H265SpsSyntax::ptr sps);
+    void StorePps(H265PpsSyntax::ptr pps);
+    template <typename T>
+    std::shared_ptr<T> MakeSyntax()
+    {
+        return _pool ? _pool->Acquire<T>() : H26xMakeShared<T>(_arena.get());
+    }
 private:
     H265ContextSyntax::ptr _contex;
+    H265ContextSyntax::ptr _lazyContex; // snapshot of _contex shared by lazy NAL units, reset by parameter sets
+    H26xBinaryReader::ptr _spanReader;
+    H26xByteStreamFeeder::ptr _feeder;
+    NalUnitCallback _nalUnitCallback;
+    H26xArena::ptr _arena;
+    H265SyntaxPool::ptr _pool;
+    H265ParameterSetStore::ptr _parameterSetStore;
+    bool _parameterSetChanged;
+    uint64_t _nalUnitTypeMask;
 };
 
 } // namespace Codec
@@ -0,0 +1,98 @@
+#include "H265LazyNalUnit.h"
+
+#include "H265Deserialize.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+static H265Deserialize& LazyNalUnitDeserializer()
+{
+    // Hint : kept by each thread and rebound to the context of every NAL unit, nothing is allocated per NAL unit
+    thread_local H265Deserialize deserialize;
+    return deserialize;
+}
+
+H265LazyNalUnit::H265LazyNalUnit(const uint8_t* data, size_t size, H265ContextSyntax::ptr contex)
+{
+    _data = data;
+    _size = size;
+    _contex = contex;
+    _nal = nullptr;
+    _deserialized = false;
+    _res = false;
+    _nalUnitTypeMask = 0xFFFFFFFFFFFFFFFF;
+    nal_unit_type = 0;
+    nuh_layer_id = 0;
+    nuh_temporal_id_plus1 = 0;
+}
+
+const uint8_t* H265LazyNalUnit::Data()
+{
+    return _data;
+}
+
+size_t H265LazyNalUnit::Size()
+{
+    return _size;
+}
+
+bool H265LazyNalUnit::Deserialized()
+{
+    return _deserialized;
+}
+
+bool H265LazyNalUnit::Result()
+{
+    Nal();
+    return _res;
+}
+
+H265NalSyntax::ptr H265LazyNalUnit::Nal()
+{
+    if (!_deserialized)
+    {
+        // Hint : on the parameter sets in effect when this NAL unit was created, the context is only read
+        H265Deserialize& deserialize = LazyNalUnitDeserializer();
+        if (!_nal)
+        {
+            _nal = std::make_shared<H265NalSyntax>();
+        }
+        deserialize.SetContext(_contex);
+        deserialize.SetNalUnitTypeMask(_nalUnitTypeMask);
+        _res = deserialize.DeserializeNalSyntax(_data, _size, _nal);
+        deserialize.SetContext(nullptr);
+        _contex = nullptr;
+        _deserialized = true;
+    }
+    return _nal;
+}
+
+H265VPSSyntax::ptr H265LazyNalUnit::Vps()
+{
+    return Nal()->vps;
+}
+
+H265SpsSyntax::ptr H265LazyNalUnit::Sps()
+{
+    return Nal()->sps;
+}
+
+H265PpsSyntax::ptr H265LazyNalUnit::Pps()
+{
+    return Nal()->pps;
+}
+
+H265SeiMessageSyntax::ptr H265LazyNalUnit::Sei()
+{
+    return Nal()->sei;
+}
+
+H265SliceHeaderSyntax::ptr H265LazyNalUnit::Slice()
+{
+    return Nal()->slice;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
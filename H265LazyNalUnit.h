@@ -0,0 +1,80 @@
+//
+// H265LazyNalUnit.h
+//
+// Library: Codec
+// Package: H265
+// Module:  H265
+// 
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "H265Common.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief NAL unit whose header is decoded up front and whose body is deserialized on first access
+ * @note  1 - created by H265Deserialize::DeserializeLazyNalUnit()
+ *        2 - no copy is made, data must stay valid until the body is deserialized (or never accessed)
+ *        3 - parameter sets are always deserialized up front, later NAL units depend on them;
+ *            other NAL units keep the parameter sets in effect when they were created
+ *        4 - the body is deserialized by the thread calling the first accessor, with a deserializer kept by
+ *            that thread; NAL units may be accessed from different threads, one NAL unit shall not be
+ *            accessed concurrently
+ *        5 - the NAL unit syntax comes from the pool of the creating deserializer, never from its arena
+ *            which is not thread safe, see also H265Deserialize::SetSyntaxPool()
+ *        6 - NAL unit types are masked as set on the creating deserializer when the NAL unit was created
+ * @sa    ITU-T H.265 (2021) - 7.3.1 NAL unit syntax
+ */
+class H265LazyNalUnit
+{
+public:
+    using ptr = std::shared_ptr<H265LazyNalUnit>;
+public:
+    H265LazyNalUnit(const uint8_t* data, size_t size, H265ContextSyntax::ptr contex);
+    ~H265LazyNalUnit() = default;
+public:
+    const uint8_t* Data();
+    size_t Size();
+    /**
+     * @brief whether the body has been deserialized
+     */
+    bool Deserialized();
+    /**
+     * @brief result of body deserialization, deserialize it if not yet
+     */
+    bool Result();
+public:
+    /**
+     * @brief fully deserialized NAL unit, deserialize it if not yet
+     */
+    H265NalSyntax::ptr Nal();
+    H265VPSSyntax::ptr Vps();
+    H265SpsSyntax::ptr Sps();
+    H265PpsSyntax::ptr Pps();
+    H265SeiMessageSyntax::ptr Sei();
+    H265SliceHeaderSyntax::ptr Slice();
+public:
+    uint8_t  nal_unit_type;
+    uint8_t  nuh_layer_id;
+    uint8_t  nuh_temporal_id_plus1;
+private:
+    friend class H265Deserialize;
+private:
+    const uint8_t*         _data;
+    size_t                 _size;
+    H265ContextSyntax::ptr _contex;
+    H265NalSyntax::ptr     _nal;
+    bool                   _deserialized;
+    bool                   _res;
+    uint64_t               _nalUnitTypeMask;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "H265ParallelDeserialize.h"
+
+#include "H26xNalSplitter.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H265ParallelDeserialize::H265ParallelDeserialize(size_t threadNum)
+{
+    _pool = std::make_shared<H26xThreadPool>(threadNum);
+    _deserialize = std::make_shared<H265Deserialize>();
+    for (size_t i=0; i<_pool->ThreadNum(); i++)
+    {
+        _workers.push_back(std::make_shared<H265Deserialize>());
+    }
+}
+
+bool H265ParallelDeserialize::DeserializeByteStream(const uint8_t* data, size_t size, std::vector<H265NalSyntax::ptr>& nals, std::vector<bool>* res)
+{
+    std::vector<H26xNalUnitInfo> infos;
+    H26xNalSplitter::Split(data, size, infos);
+    size_t count = infos.size();
+    std::vector<H265NalSyntax::ptr> results(count);
+    std::vector<uint8_t> ok(count, 0);
+    // Hint : parameter sets pass, snapshots[i] is the context in effect for NAL unit i
+    std::vector<H265ContextSyntax::ptr> snapshots(count);
+    H265ContextSyntax::ptr snapshot = std::make_shared<H265ContextSyntax>(*_deserialize->GetContext());
+    for (size_t i=0; i<count; i++)
+    {
+        uint8_t nalUnitType = (infos[i].header >> 1) & 0x3F;
+        if (nalUnitType == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT || nalUnitType == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT ||
+            nalUnitType == H265NaluType::MMP_H265_NALU_TYPE_PPS_NUT)
+        {
+            results[i] = std::make_shared<H265NalSyntax>();
+            ok[i] = _deserialize->DeserializeNalSyntax(data + infos[i].offset, infos[i].size, results[i]);
+            snapshot = nullptr;
+            continue;
+        }
+        if (!snapshot)
+        {
+            snapshot = std::make_shared<H265ContextSyntax>(*_deserialize->GetContext());
+        }
+        snapshots[i] = snapshot;
+    }
+    // Hint : slices and SEI pass
+    std::vector<H265ContextSyntax*> workerSnapshots(_workers.size(), nullptr);
+    _pool->ParallelFor(count, 16, [&](size_t threadIndex, size_t begin, size_t end) -> void
+    {
+        H265Deserialize::ptr deserialize = _workers[threadIndex];
+        for (size_t i=begin; i<end; i++)
+        {
+            if (!snapshots[i])
+            {
+                continue;
+            }
+            if (workerSnapshots[threadIndex] != snapshots[i].get())
+            {
+                // Hint : private copy, the snapshot is shared by all threads and never modified
+                deserialize->SetContext(std::make_shared<H265ContextSyntax>(*snapshots[i]));
+                workerSnapshots[threadIndex] = snapshots[i].get();
+            }
+            results[i] = std::make_shared<H265NalSyntax>();
+            ok[i] = deserialize->DeserializeNalSyntax(data + infos[i].offset, infos[i].size, results[i]);
+        }
+    });
+    bool allOk = true;
+    for (size_t i=0; i<count; i++)
+    {
+        nals.push_back(results[i]);
+        if (res)
+        {
+            res->push_back(ok[i] != 0);
+        }
+        allOk = allOk && ok[i];
+    }
+    return allOk;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,58 @@
+//
+// H265ParallelDeserialize.h
+//
+// Library: Codec
+// Package: H265
+// Module:  H265
+// 
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "H265Common.h"
+#include "H265Deserialize.h"
+#include "H26xThreadPool.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief deserialize a whole byte stream with a thread pool, for batch analysis of long streams
+ * @note  1 - NAL units are located by H26xNalSplitter first
+ *        2 - VPS, SPS and PPS are deserialized sequentially, each one yields an immutable snapshot of the context
+ *        3 - other NAL units (slice headers, SEI) are deserialized by the pool, each thread has its own
+ *            H265Deserialize (hence its own bit reader) running on a private copy of the snapshot in effect
+ *        4 - results are stored by NAL unit number, i.e. in stream order
+ *        5 - parameter sets are kept from one call to the next, as H265Deserialize does
+ * @sa    ITU-T H.265 (2021) - 7.4.2.4.2 Order of VPS, SPS and PPS RBSPs and their activation
+ */
+class H265ParallelDeserialize
+{
+public:
+    using ptr = std::shared_ptr<H265ParallelDeserialize>;
+public:
+    /**
+     * @param threadNum : 0 for std::thread::hardware_concurrency()
+     */
+    explicit H265ParallelDeserialize(size_t threadNum = 0);
+    ~H265ParallelDeserialize() = default;
+public:
+    /**
+     * @brief deserialize all NAL units of a byte stream (Annex B) held in memory
+     * @param nals : deserialized NAL units are appended, in stream order
+     * @param res  : result of each NAL unit is appended (optional)
+     */
+    bool DeserializeByteStream(const uint8_t* data, size_t size, std::vector<H265NalSyntax::ptr>& nals, std::vector<bool>* res = nullptr);
+private:
+    H26xThreadPool::ptr               _pool;
+    H265Deserialize::ptr              _deserialize; // parameter sets pass
+    std::vector<H265Deserialize::ptr> _workers;     // one per pool thread
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "H265ParameterSetStore.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H265ParameterSetStore::ptr H265ParameterSetStore::Global()
+{
+    static H265ParameterSetStore::ptr store = std::make_shared<H265ParameterSetStore>();
+    return store;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
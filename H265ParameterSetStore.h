@@ -0,0 +1,47 @@
+//
+// H265ParameterSetStore.h
+//
+// Library: Codec
+// Package: H265
+// Module:  H265
+// 
+
+#pragma once
+
+#include <memory>
+
+#include "H265Common.h"
+#include "H26xParameterSetTable.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief parameter sets interned across streams, each byte identical parameter set is deserialized once
+ *        and every context refers to the same object
+ * @note  1 - thread safe, one store may be shared by any number of deserializers, see also H265Deserialize::SetParameterSetStore()
+ *        2 - interned parameter sets shall never be modified
+ *        3 - SPS (PPS) are shared between streams whose VPS (SPS) is the same interned one
+ */
+class H265ParameterSetStore
+{
+public:
+    using ptr = std::shared_ptr<H265ParameterSetStore>;
+public:
+    H265ParameterSetStore() = default;
+    ~H265ParameterSetStore() = default;
+public:
+    /**
+     * @brief store shared by the whole process
+     */
+    static H265ParameterSetStore::ptr Global();
+public:
+    H26xParameterSetTable<H265VPSSyntax> vpsTable;
+    H26xParameterSetTable<H265SpsSyntax> spsTable;
+    H26xParameterSetTable<H265PpsSyntax> ppsTable;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
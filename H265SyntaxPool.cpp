@@ -0,0 +1,67 @@
+#include "H265SyntaxPool.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H265SyntaxPool::H265SyntaxPool(size_t maxNalCount)
+{
+    _maxNalCount = maxNalCount;
+    _cursor = 0;
+}
+
+H265NalSyntax::ptr H265SyntaxPool::AcquireNalSyntax()
+{
+    // Hint : round robin from the last one handed out, NAL units are usually released in order
+    for (size_t i=0; i<_nals.size(); i++)
+    {
+        size_t index = (_cursor + i) % _nals.size();
+        if (_nals[index].use_count() == 1)
+        {
+            ResetSyntax(*_nals[index]);
+            _cursor = index + 1;
+            return _nals[index];
+        }
+    }
+    H265NalSyntax::ptr nal = std::make_shared<H265NalSyntax>();
+    if (_nals.size() < _maxNalCount)
+    {
+        _nals.push_back(nal);
+        _cursor = 0;
+    }
+    return nal;
+}
+
+void H265SyntaxPool::ResetSyntax(H265NalSyntax& nal)
+{
+    Recycle(nal.header);
+    Recycle(nal.slice);
+    nal = H265NalSyntax();
+}
+
+void H265SyntaxPool::ResetSyntax(H265SliceHeaderSyntax& slice)
+{
+    Recycle(slice.stps);
+    Recycle(slice.rplm);
+    Recycle(slice.pwt);
+    slice.Reset();
+}
+
+void H265SyntaxPool::ResetSyntax(H265StRefPicSetSyntax& stps)
+{
+    stps.Reset();
+}
+
+void H265SyntaxPool::ResetSyntax(H265RefPicListsModificationSyntax& rplm)
+{
+    rplm.Reset();
+}
+
+void H265SyntaxPool::ResetSyntax(H265PredWeightTableSyntax& pwt)
+{
+    pwt.Reset();
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
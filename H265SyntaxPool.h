@@ -0,0 +1,91 @@
+//
+// H265SyntaxPool.h
+//
+// Library: Codec
+// Package: H265
+// Module:  H265
+//
+
+#pragma once
+
+#include <tuple>
+#include <memory>
+#include <vector>
+
+#include "H265Common.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief recycle per NAL unit syntax trees instead of reallocating them
+ * @note  1 - AcquireNalSyntax() hands out a NAL unit no longer referenced outside the pool, its children
+ *            (NAL unit header, slice segment header and so on) go back to the pool and every field is reset
+ *        2 - recycled vectors are cleared but keep their capacity, in steady state deserializing a long stream
+ *            makes no heap allocation for per NAL unit syntax
+ *        3 - a syntax object still referenced elsewhere is never recycled, parameter sets are kept by the context
+ *            and are never recycled
+ *        4 - not thread safe, one pool per deserializer, see also H265Deserialize::SetSyntaxPool()
+ */
+class H265SyntaxPool
+{
+public:
+    using ptr = std::shared_ptr<H265SyntaxPool>;
+public:
+    /**
+     * @param maxNalCount : NAL units tracked by the pool, NAL units acquired beyond are not recycled
+     */
+    explicit H265SyntaxPool(size_t maxNalCount = 16);
+    ~H265SyntaxPool() = default;
+public:
+    H265NalSyntax::ptr AcquireNalSyntax();
+    template <typename T>
+    std::shared_ptr<T> Acquire()
+    {
+        std::vector<std::shared_ptr<T>>& bin = std::get<std::vector<std::shared_ptr<T>>>(_bins);
+        if (bin.empty())
+        {
+            return std::make_shared<T>();
+        }
+        std::shared_ptr<T> syntax = std::move(bin.back());
+        bin.pop_back();
+        return syntax;
+    }
+private:
+    template <typename T>
+    void Recycle(std::shared_ptr<T>& syntax)
+    {
+        if (syntax && syntax.use_count() == 1)
+        {
+            ResetSyntax(*syntax);
+            std::get<std::vector<std::shared_ptr<T>>>(_bins).push_back(std::move(syntax));
+        }
+        syntax = nullptr;
+    }
+    template <typename T>
+    void ResetSyntax(T& syntax)
+    {
+        syntax = T();
+    }
+    void ResetSyntax(H265NalSyntax& nal);
+    void ResetSyntax(H265SliceHeaderSyntax& slice);
+    void ResetSyntax(H265StRefPicSetSyntax& stps);
+    void ResetSyntax(H265RefPicListsModificationSyntax& rplm);
+    void ResetSyntax(H265PredWeightTableSyntax& pwt);
+private:
+    size_t                          _maxNalCount;
+    size_t                          _cursor;
+    std::vector<H265NalSyntax::ptr> _nals;
+    std::tuple<
+        std::vector<H265NalUnitHeaderSyntax::ptr>,
+        std::vector<H265SliceHeaderSyntax::ptr>,
+        std::vector<H265StRefPicSetSyntax::ptr>,
+        std::vector<H265RefPicListsModificationSyntax::ptr>,
+        std::vector<H265PredWeightTableSyntax::ptr>
+    > _bins;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
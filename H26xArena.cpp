@@ -0,0 +1,97 @@
+#include "H26xArena.h"
+
+#include <cassert>
+
+#include "H26xUltis.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xArena::H26xArena(size_t blockSize)
+{
+    _blockSize = blockSize ? blockSize : 1;
+    _blockIndex = 0;
+    _offset = 0;
+    _allocationCount = 0;
+    _bytesUsed = 0;
+    _liveCount = 0;
+}
+
+H26xArena::~H26xArena()
+{
+    assert(_liveCount == 0);
+    for (auto& block : _blocks)
+    {
+        delete[] block.first;
+    }
+}
+
+void* H26xArena::Allocate(size_t size, size_t alignment)
+{
+    // Hint : search the current block then the following ones (kept from previous rounds), grow if none fits
+    while (_blockIndex < _blocks.size())
+    {
+        uintptr_t base = (uintptr_t)_blocks[_blockIndex].first;
+        size_t offset = (size_t)(((base + _offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base);
+        if (offset + size <= _blocks[_blockIndex].second)
+        {
+            _offset = offset + size;
+            _allocationCount++;
+            _bytesUsed += size;
+            _liveCount++;
+            return (void*)(base + offset);
+        }
+        _blockIndex++;
+        _offset = 0;
+    }
+    size_t blockSize = size + alignment > _blockSize ? size + alignment : _blockSize;
+    _blocks.push_back(std::make_pair(new uint8_t[blockSize], blockSize));
+    _blockIndex = _blocks.size() - 1;
+    _offset = 0;
+    return Allocate(size, alignment);
+}
+
+void H26xArena::Deallocate(void* /* p */, size_t /* size */)
+{
+    assert(_liveCount > 0);
+    _liveCount--;
+}
+
+void H26xArena::Reset()
+{
+    // Hint : rewinding would hand out memory still in use, the arena keeps growing instead
+    if (_liveCount != 0)
+    {
+        H26x_LOG_ERROR << "[Arena] reset with " << _liveCount << " live allocations, ignored" << H26x_LOG_TERMINATOR;
+        return;
+    }
+    _blockIndex = 0;
+    _offset = 0;
+    _allocationCount = 0;
+    _bytesUsed = 0;
+}
+
+size_t H26xArena::AllocationCount()
+{
+    return _allocationCount;
+}
+
+size_t H26xArena::BytesUsed()
+{
+    return _bytesUsed;
+}
+
+size_t H26xArena::Capacity()
+{
+    size_t capacity = 0;
+    for (auto& block : _blocks)
+    {
+        capacity += block.second;
+    }
+    return capacity;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,121 @@
+//
+// H26xArena.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief monotonic memory arena for per NAL unit (or per access unit) syntax trees
+ * @note  1 - memory is carved from blocks in sequence, nothing is freed until Reset()
+ *        2 - Reset() rewinds to the first block, blocks are kept and reused, in steady state
+ *            no heap allocation is made at all
+ *        3 - everything allocated from the arena shall be released before Reset(), otherwise Reset() is ignored
+ *        4 - not thread safe, one arena per deserializer
+ */
+class H26xArena
+{
+public:
+    using ptr = std::shared_ptr<H26xArena>;
+public:
+    explicit H26xArena(size_t blockSize = 64 * 1024);
+    ~H26xArena();
+public:
+    void* Allocate(size_t size, size_t alignment);
+    /**
+     * @note memory is not reclaimed, only live allocations are counted
+     */
+    void Deallocate(void* p, size_t size);
+    void Reset();
+public:
+    /**
+     * @brief allocations since last Reset()
+     */
+    size_t AllocationCount();
+    /**
+     * @brief bytes allocated since last Reset()
+     */
+    size_t BytesUsed();
+    /**
+     * @brief bytes reserved by blocks
+     */
+    size_t Capacity();
+private:
+    size_t                                   _blockSize;
+    std::vector<std::pair<uint8_t*, size_t>> _blocks;     // data, size
+    size_t                                   _blockIndex;
+    size_t                                   _offset;     // in _blocks[_blockIndex]
+    size_t                                   _allocationCount;
+    size_t                                   _bytesUsed;
+    size_t                                   _liveCount;
+};
+
+/**
+ * @brief standard allocator over H26xArena, such as for std::allocate_shared
+ */
+template <typename T>
+class H26xArenaAllocator
+{
+public:
+    using value_type = T;
+public:
+    explicit H26xArenaAllocator(H26xArena* arena) : arena(arena) {}
+    template <typename U>
+    H26xArenaAllocator(const H26xArenaAllocator<U>& other) : arena(other.arena) {}
+public:
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, size_t n)
+    {
+        arena->Deallocate(p, n * sizeof(T));
+    }
+public:
+    H26xArena* arena;
+};
+
+template <typename T, typename U>
+bool operator==(const H26xArenaAllocator<T>& lhs, const H26xArenaAllocator<U>& rhs)
+{
+    return lhs.arena == rhs.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const H26xArenaAllocator<T>& lhs, const H26xArenaAllocator<U>& rhs)
+{
+    return lhs.arena != rhs.arena;
+}
+
+/**
+ * @brief std::allocate_shared from arena, std::make_shared if arena is nullptr
+ * @note  object and control block are carved together from the arena
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> H26xMakeShared(H26xArena* arena, Args&&... args)
+{
+    if (arena)
+    {
+        return std::allocate_shared<T>(H26xArenaAllocator<T>(arena), std::forward<Args>(args)...);
+    }
+    else
+    {
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
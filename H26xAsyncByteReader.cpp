@@ -0,0 +1,212 @@
+#include "H26xAsyncByteReader.h"
+
+#include <cstring>
+
+#include "H26xUltis.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xAsyncByteReader::H26xAsyncByteReader(const std::string& path, size_t bufferCount, size_t bufferSize)
+{
+    _isOpen = false;
+    _filled = 0;
+    _fillIndex = 0;
+    _fillOffset = 0;
+    _generation = 0;
+    _ioEnd = false;
+    _quit = false;
+    _cur = nullptr;
+    _readIndex = 0;
+    _pos = 0;
+    _offset = 0;
+    _eof = false;
+    _size = 0;
+    _ifs.open(path, std::ios::in | std::ios::binary);
+    if (!_ifs.is_open())
+    {
+        H26x_LOG_ERROR << "[H26x] open " << path << " fail" << H26x_LOG_TERMINATOR;
+        return;
+    }
+    _ifs.seekg(0, std::ios::end);
+    _size = (uint64_t)_ifs.tellg();
+    _ifs.seekg(0, std::ios::beg);
+    _buffers.resize(bufferCount < 2 ? 2 : bufferCount);
+    for (Buffer& buffer : _buffers)
+    {
+        buffer.data.resize(bufferSize ? bufferSize : 1);
+        buffer.len = 0;
+        buffer.offset = 0;
+        buffer.last = false;
+    }
+    _isOpen = true;
+    _thread = std::thread(&H26xAsyncByteReader::IoThread, this);
+}
+
+H26xAsyncByteReader::~H26xAsyncByteReader()
+{
+    if (_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _quit = true;
+        }
+        _freedCond.notify_all();
+        _thread.join();
+    }
+}
+
+bool H26xAsyncByteReader::IsOpen()
+{
+    return _isOpen;
+}
+
+size_t H26xAsyncByteReader::Read(void* data, size_t bytes)
+{
+    size_t readBytes = 0;
+    while (readBytes < bytes)
+    {
+        if (!_cur || _pos == _cur->len)
+        {
+            if (_cur && _cur->last)
+            {
+                break;
+            }
+            Release();
+            if (!Acquire())
+            {
+                break;
+            }
+            continue;
+        }
+        size_t copyBytes = (bytes - readBytes) < (_cur->len - _pos) ? (bytes - readBytes) : (_cur->len - _pos);
+        memcpy((uint8_t*)data + readBytes, _cur->data.data() + _pos, copyBytes);
+        _pos += copyBytes;
+        _offset += copyBytes;
+        readBytes += copyBytes;
+    }
+    if (readBytes < bytes)
+    {
+        _eof = true;
+    }
+    return readBytes;
+}
+
+bool H26xAsyncByteReader::Seek(size_t offset)
+{
+    size_t seekOffset = offset;
+    _eof = false;
+    if (!_isOpen)
+    {
+        return false;
+    }
+    if (offset > _size)
+    {
+        offset = (size_t)_size;
+    }
+    if (_cur && offset >= _cur->offset && offset <= _cur->offset + _cur->len)
+    {
+        _pos = (size_t)(offset - _cur->offset);
+        _offset = offset;
+        return true;
+    }
+    // Hint : drop everything read ahead, the I/O thread restarts from offset
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _generation++;
+        _filled = 0;
+        _fillIndex = 0;
+        _fillOffset = offset;
+        _ioEnd = false;
+    }
+    _freedCond.notify_all();
+    _cur = nullptr;
+    _readIndex = 0;
+    _pos = 0;
+    _offset = offset;
+    return offset == seekOffset;
+}
+
+size_t H26xAsyncByteReader::Tell()
+{
+    return (size_t)_offset;
+}
+
+bool H26xAsyncByteReader::Eof()
+{
+    return _eof || !_isOpen;
+}
+
+void H26xAsyncByteReader::IoThread()
+{
+    uint64_t filePos = 0;
+    std::unique_lock<std::mutex> lock(_mtx);
+    while (!_quit)
+    {
+        if (_ioEnd || _filled == _buffers.size())
+        {
+            _freedCond.wait(lock);
+            continue;
+        }
+        Buffer& buffer = _buffers[_fillIndex];
+        uint64_t generation = _generation;
+        uint64_t offset = _fillOffset;
+        lock.unlock();
+        // Hint : the buffer is not visible to the consumer until _filled grows, fill it unlocked
+        if (filePos != offset)
+        {
+            _ifs.clear();
+            _ifs.seekg((std::streamoff)offset);
+        }
+        _ifs.read((char*)buffer.data.data(), (std::streamsize)buffer.data.size());
+        size_t len = (size_t)_ifs.gcount();
+        filePos = offset + len;
+        bool last = len < buffer.data.size();
+        lock.lock();
+        if (generation != _generation)
+        {
+            continue;
+        }
+        buffer.len = len;
+        buffer.offset = offset;
+        buffer.last = last;
+        _fillOffset = offset + len;
+        _fillIndex = (_fillIndex + 1) % _buffers.size();
+        _filled++;
+        _ioEnd = last;
+        _filledCond.notify_one();
+    }
+}
+
+bool H26xAsyncByteReader::Acquire()
+{
+    if (!_isOpen)
+    {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(_mtx);
+    _filledCond.wait(lock, [this]() { return _filled != 0; });
+    _cur = &_buffers[_readIndex];
+    _pos = (size_t)(_offset - _cur->offset);
+    return true;
+}
+
+void H26xAsyncByteReader::Release()
+{
+    if (!_cur)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _filled--;
+    }
+    _freedCond.notify_one();
+    _readIndex = (_readIndex + 1) % _buffers.size();
+    _cur = nullptr;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,90 @@
+//
+// H26xAsyncByteReader.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "AbstractH26xByteReader.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief AbstractH26xByteReader implemention with asynchronous read ahead
+ * @note  1 - a background I/O thread fills a ring of buffers while the parser consumes the current one,
+ *            so that parsing is bounded by max(I/O, CPU) rather than their sum
+ *        2 - bufferCount >= 2 (double buffering), more buffers absorb I/O jitter
+ *        3 - Seek() inside the current buffer costs nothing, otherwise buffers read ahead are dropped
+ *            and the I/O thread restarts from the new position
+ */
+class H26xAsyncByteReader : public AbstractH26xByteReader
+{
+public:
+    using ptr = std::shared_ptr<H26xAsyncByteReader>;
+public:
+    /**
+     * @param[in] path
+     * @param[in] bufferCount : number of buffers in the ring, at least 2
+     * @param[in] bufferSize : bytes per buffer
+     */
+    explicit H26xAsyncByteReader(const std::string& path, size_t bufferCount = 2, size_t bufferSize = 1024 * 1024);
+    ~H26xAsyncByteReader();
+public:
+    bool IsOpen();
+public:
+    size_t Read(void* data, size_t bytes) override;
+    bool Seek(size_t offset) override;
+    size_t Tell() override;
+    bool Eof() override;
+private:
+    void IoThread();
+    bool Acquire();
+    void Release();
+private:
+    class Buffer
+    {
+    public:
+        std::vector<uint8_t> data;
+        size_t               len;
+        uint64_t             offset; // file offset of data[0]
+        bool                 last;   // end of file reached by this buffer
+    };
+private:
+    std::ifstream _ifs;
+    bool          _isOpen;
+    uint64_t      _size;
+    std::thread   _thread;
+private: /* shared with I/O thread, guarded by _mtx */
+    std::mutex              _mtx;
+    std::condition_variable _filledCond;
+    std::condition_variable _freedCond;
+    std::vector<Buffer>     _buffers;
+    size_t                  _filled;     // buffers ready for consumer
+    size_t                  _fillIndex;  // next buffer the I/O thread fills
+    uint64_t                _fillOffset; // file offset the I/O thread reads next
+    uint64_t                _generation; // bumped by Seek(), data read for an older generation is dropped
+    bool                    _ioEnd;      // I/O thread reached end of file (or failed)
+    bool                    _quit;
+private: /* consumer only */
+    Buffer*  _cur;      // buffer being consumed, nullptr if none
+    size_t   _readIndex;
+    size_t   _pos;      // position in *_cur
+    uint64_t _offset;   // file offset of the next byte read
+    bool     _eof;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
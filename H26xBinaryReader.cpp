@@ -2,10 +2,15 @@
 
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <exception>
 #include <stdexcept>
 #include <string>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif /* _MSC_VER */
+
 #include "H26xUltis.h"
 
 namespace Mmp
@@ -42,234 +47,226 @@ namespace Codec
 //  descriptor is specified in subclause 9.1.
 //
 
-static uint8_t kLeftAndLookUp[8] = {0xFF, 0x7F, 0x3F, 0x1F, 0x0F, 0x07, 0x03, 0x01};
-static uint8_t kRightAndLookUp[8] = {0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE, 0xFF};
+// Hint : with MMP_H26X_NO_EXCEPTIONS nothing is thrown, the sticky error flag is set and zeros are returned instead,
+//        see also H26xBinaryReader::Error
+#ifndef MMP_H26X_NO_EXCEPTIONS
+#define MMP_H26X_READER_ERROR(exception, exp)       _error = true; throw exception;
+#else
+#define MMP_H26X_READER_ERROR(exception, exp)       _error = true; exp;
+#endif /* MMP_H26X_NO_EXCEPTIONS */
 
+constexpr size_t kChunkSize = 64 * 1024;
+constexpr size_t kKeepBackSize = 32; // bytes of the previous chunk kept in front of the current one, so that short rewinds need no seek
 
-H26xBinaryReader::H26xBinaryReader(AbstractH26xByteReader::ptr reader)
+static inline uint64_t LoadBE64(const uint8_t* data)
 {
-    _rbspEndByte = 0;
-    _curBitPos = 8;
-    _curValue = 0;
-    _reader = reader;
-    _inNalUnit = false;
-    _zeroCount = 0;
+    uint64_t value = 0;
+    memcpy(&value, data, sizeof(uint64_t));
+#if defined(_MSC_VER)
+    return _byteswap_uint64(value);
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return value;
+#else
+    return __builtin_bswap64(value);
+#endif
 }
 
-H26xBinaryReader::~H26xBinaryReader()
+static inline uint32_t CountTrailingZero64(uint64_t value)
 {
-
+    assert(value != 0);
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctzll(value);
+#endif
 }
 
-void H26xBinaryReader::UE(uint32_t& value)
+static inline uint32_t PopCount32(uint32_t value)
 {
-    // See also : ISO 14496/10(2020) - 9.1 Parsing process for Exp-Golomb codes
-    int32_t leadingZeroBits = -1;
-    uint64_t tmp = 0;
-    for (uint8_t b = 0; b == 0; leadingZeroBits++)
+    uint32_t count = 0;
+    for (; value; value &= value - 1)
     {
-        U(1, b);
-        assert(b == 0 || b == 1);
+        count++;
     }
-    U(leadingZeroBits, tmp);
-    value = (1 << leadingZeroBits) - 1 + tmp;
+    return count;
 }
 
-void H26xBinaryReader::SE(int32_t& value)
+static inline bool HasZeroByte(uint64_t value)
 {
-    // See also : ISO 14496/10(2020) -  Table 9-3 – Assignment of syntax element to codeNum for signed Exp-Golomb coded syntax elements se(v)}
-    uint32_t codeNum = 0;
-    UE(codeNum);
-    if (codeNum % 2 == 0)
-    {
-        value = -(codeNum >> 1);
-    }
-    else
-    {
-        value = (codeNum >> 1) + 1;
-    }
+    return ((value - 0x0101010101010101ULL) & ~value & 0x8080808080808080ULL) != 0;
 }
 
-#define MMP_U_OPERATION(bits, value)            value = 0;\
-                                                bool firstFlag = false;\
-                                                do\
-                                                {\
-                                                    ReadOneByteAuto();\
-                                                    size_t readBits = bits <= (8 - (size_t)_curBitPos)? bits : (8 - (size_t)_curBitPos);\
-                                                    bits = bits - readBits;\
-                                                    value <<= readBits;\
-                                                    if (readBits < 8 && !firstFlag)\
-                                                    {\
-                                                        value |= (_curValue & kLeftAndLookUp[_curBitPos]) >> (8 - _curBitPos - readBits);\
-                                                    }\
-                                                    else if (readBits < 8)\
-                                                    {\
-                                                        value |= (_curValue & kRightAndLookUp[readBits - 1]) >> (8 - _curBitPos - readBits);\
-                                                    }\
-                                                    else\
-                                                    {\
-                                                        value |= _curValue;\
-                                                    }\
-                                                    _curBitPos = _curBitPos + readBits;\
-                                                    firstFlag = true;\
-                                                } while (bits != 0);
-
-#define MMP_U_PRED_OPERATION(bits, value)       uint8_t curBitPos = _curBitPos;\
-                                                size_t curPosByte = curBitPos == 8 ? _reader->Tell() : _reader->Tell() - 1;\
-                                                MMP_U_OPERATION(bits, value);\
-                                                _reader->Seek(curPosByte);\
-                                                if (curBitPos != 8)\
-                                                {\
-                                                    ReadOneByteAuto(true);\
-                                                }\
-                                                _curBitPos = curBitPos;
-
-#define MMP_I_OPERATION(bits, value)            MMP_U_OPERATION(bits, value)
-
-#define MMP_I_PRED_OPERATION(bits, value)       MMP_U_PRED_OPERATION(bits, value)
-
-void H26xBinaryReader::U(size_t bits, uint64_t& value)
-{
-    if (bits > 64)
-    {
-        throw std::out_of_range(std::string());
-    }
-    MMP_U_OPERATION(bits, value);
+H26xBinaryReader::H26xBinaryReader(AbstractH26xByteReader::ptr reader)
+{
+    _cache = 0;
+    _cacheBits = 0;
+    _cacheEscapes = 0;
+    _data = nullptr;
+    _dataLen = 0;
+    _dataPos = 0;
+    _dataBase = 0;
+    _dataBaseValid = false;
+    _eof = false;
+    _zeroCount = 0;
+    _rbspStopBit = 0;
+    _rbspStopBitValid = false;
+    _nalSize = 0;
+    _nalSizeValid = false;
+    _nalEnd = 0;
+    _nalEndValid = false;
+    _inNalUnit = false;
+    _escaped = true;
+    _error = false;
+    _reader = reader;
 }
 
-void H26xBinaryReader::U(size_t bits, uint32_t& value, bool probe)
+H26xBinaryReader::H26xBinaryReader(const uint8_t* data, size_t size, bool escaped)
 {
-    if (bits > 32)
-    {
-        throw std::out_of_range(std::string());
-    }
-    if (!probe)
-    {
-        MMP_U_OPERATION(bits, value);
-    }
-    else
-    {
-        MMP_U_PRED_OPERATION(bits, value);
-    }
+    _reader = nullptr;
+    Reset(data, size, escaped);
 }
 
-void H26xBinaryReader::U(size_t bits, uint16_t& value)
+H26xBinaryReader::~H26xBinaryReader()
 {
-    if (bits > 16)
-    {
-        throw std::out_of_range(std::string());
-    }
-    MMP_U_OPERATION(bits, value);
+
 }
 
-void H26xBinaryReader::U(size_t bits, uint8_t& value, bool probe)
+void H26xBinaryReader::Reset(const uint8_t* data, size_t size, bool escaped)
 {
-    if (bits > 8)
-    {
-        throw std::out_of_range(std::string());
-    }
-    if (!probe)
-    {
-        MMP_U_OPERATION(bits, value);
-    }
-    else
-    {
-        MMP_U_PRED_OPERATION(bits, value);
-    }
+    assert(!_reader);
+    _cache = 0;
+    _cacheBits = 0;
+    _cacheEscapes = 0;
+    _data = data;
+    _dataLen = size;
+    _dataPos = 0;
+    _dataBase = 0;
+    _dataBaseValid = true;
+    _eof = false;
+    _zeroCount = 0;
+    _rbspStopBit = 0;
+    _rbspStopBitValid = false;
+    _nalSize = 0;
+    _nalSizeValid = false;
+    _nalEnd = 0;
+    _nalEndValid = false;
+    _inNalUnit = false;
+    _escaped = escaped;
+    _error = false;
 }
 
-void H26xBinaryReader::I(size_t bits, int64_t& value)
+void H26xBinaryReader::UESlow(uint32_t& value)
 {
-    if (bits > 64)
+    // See also : ISO 14496/10(2020) - 9.1 Parsing process for Exp-Golomb codes
+    // Hint : leadingZeroBits is counted on the bit cache directly, then prefix and suffix
+    //        (2 * leadingZeroBits + 1 bits in total) are consumed in one step.
+    if (_cacheBits < 32)
     {
-        throw std::out_of_range(std::string());
+        FillCache();
     }
-    MMP_I_OPERATION(bits, value);
-}
-
-void H26xBinaryReader::I(size_t bits, int32_t& value)
-{
-    if (bits > 32)
+    uint32_t leadingZeroBits = _cache ? CountLeadingZero64(_cache) : 64;
+    if (leadingZeroBits > 31)
     {
-        throw std::out_of_range(std::string());
+        value = 0;
+        if (_cacheBits < 32)
+        {
+            _eof = true;
+            MMP_H26X_READER_ERROR(std::out_of_range(std::string()), return);
+        }
+        // Hint : codeNum is at most 2^32 - 2, longer prefix is malformed
+        MMP_H26X_READER_ERROR(std::invalid_argument("[ue] leadingZeroBits out of range"), return);
     }
-    MMP_I_OPERATION(bits, value);
-}
-
-void H26xBinaryReader::I(size_t bits, int16_t& value)
-{
-    if (bits > 16)
+    uint32_t codeBits = 2 * leadingZeroBits + 1;
+    if (codeBits <= _cacheBits)
     {
-        throw std::out_of_range(std::string());
+        value = (uint32_t)((_cache >> (64 - codeBits)) - 1);
+        _cache <<= codeBits;
+        _cacheBits -= codeBits;
     }
-    MMP_I_OPERATION(bits, value);
-}
-
-void H26xBinaryReader::I(size_t bits, int8_t& value)
-{
-    if (bits > 8)
+    else
     {
-        throw std::out_of_range(std::string());
+        ReadBits(leadingZeroBits + 1);
+        value = (uint32_t)(((uint64_t)1 << leadingZeroBits) - 1 + ReadBits(leadingZeroBits));
     }
-    MMP_I_OPERATION(bits, value);
 }
 
-#undef MMP_I_PRED_OPERATION
-#undef MMP_I_OPERATION
-#undef MMP_U_PRED_OPERATION
-#undef MMP_U_OPERATION
-
-void H26xBinaryReader::B8(uint8_t& value)
+void H26xBinaryReader::BitsOutOfRange()
 {
-    U(8, value);
+    MMP_H26X_READER_ERROR(std::out_of_range(std::string()), return);
 }
 
-void H26xBinaryReader::Skip(size_t bits)
+void H26xBinaryReader::SkipSlow(size_t bits)
 {
-    if (bits + _curBitPos < 8) // 不需要跳转至下一个字节
+    if (!_inNalUnit) // NAL 外不存在 emulation_prevention_three_byte, 直接跳转
     {
-        _curBitPos = bits + _curBitPos;
+        Rewind(CurBits() + bits);
         return;
     }
-    else // 需要跳转的 bits 先用消费当前 byte 剩余的 bits
+    for (; bits > 32; bits -= 32)
     {
-        bits = bits - (8 - _curBitPos);
-        _curBitPos = 8;
+        ReadBits(32);
     }
-    size_t skipByte = bits / 8; // 计算需要跳转的字节数
-    if (skipByte)
-    {
-        _reader->Seek(_reader->Tell() + skipByte);
-    }
-    ReadOneByteAuto(true);
-    _curBitPos = bits % 8;
+    ReadBits(bits);
 }
 
-void H26xBinaryReader::MoveNextByte()
+bool H26xBinaryReader::Error()
 {
-    _curBitPos = 8;
-    ReadOneByteAuto();
+    return _error;
 }
 
 bool H26xBinaryReader::Eof()
 {
-    return _reader->Eof();
+    return _eof || (_cacheBits == 0 && _dataPos == _dataLen && (!_reader || _reader->Eof()));
+}
+
+void H26xBinaryReader::SetNalUnitSize(size_t nalSize)
+{
+    _nalSize = nalSize;
+    _nalSizeValid = true;
 }
 
 void H26xBinaryReader::BeginNalUnit()
 {
+    // Hint : the cache may hold bytes read ahead without emulation prevention (start code probing),
+    //        read them once again in NAL unit mode
+    if (_cacheBits)
+    {
+        Rewind(CurBits());
+    }
     _inNalUnit = true;
+    _error = false;
+    _rbspStopBitValid = false;
+    _nalEndValid = _nalSizeValid;
+    _nalEnd = _nalSizeValid ? CurBits() / 8 + _nalSize : 0;
+    _nalSizeValid = false;
 }
 
 
 void H26xBinaryReader::EndNalUnit()
 {
+    // Hint : NAL unit always ends at byte boundary, and the bytes after it should be read as they are
     _inNalUnit = false;
+    _rbspStopBitValid = false;
+    if (_nalEndValid) // NAL unit size is known, skip what is not parsed (such as slice data) at once
+    {
+        _nalEndValid = false;
+        Rewind(_nalEnd * 8);
+    }
+    else if (_cacheBits)
+    {
+        Rewind((CurBits() + 7) & ~((uint64_t)7));
+    }
 }
 
 size_t H26xBinaryReader::CurBits()
 {
-    return _reader->Tell() * 8 + (_curBitPos % 8);
+    // Hint : every cached byte is a whole byte of the byte stream, emulation_prevention_three_byte
+    //        dropped in front of a cached byte (still unconsumed) is counted back via _cacheEscapes
+    uint32_t fullBytes = _cacheBits / 8;
+    uint32_t escapes = PopCount32(_cacheEscapes & ((1u << fullBytes) - 1));
+    return (size_t)((_dataBase + _dataPos) * 8 - _cacheBits - escapes * 8);
 }
 
 bool H26xBinaryReader::more_rbsp_data()
@@ -284,77 +281,34 @@ bool H26xBinaryReader::more_rbsp_data()
     //   more_rbsp_data( ) is equal to TRUE.
     // - Otherwise, the return value of more_rbsp_data( ) is equal to FALSE.
     //
-    // Hint : 寻找下一个 RBSP 起点 NAL START CODE (0x000003),
-    //        根据 ISO 描述, 在 rbsp_trailing_bits() 后可能存在几个字节的 zero, 此部分不算做 RBSP 范畴内
-    //        
-    if (_rbspEndByte > _reader->Tell()) // cache hint
-    {
-        return true;
-    }
-    else if (_reader->Tell() == _rbspEndByte) // reach end of rbsp
+    if (_error)
     {
         return false;
     }
-    else // update _rbspEndByte and try once again
+    if (!_rbspStopBitValid)
     {
-        bool inNalUnit = _inNalUnit;
-        _inNalUnit = false;
-        uint8_t curBitPos = _curBitPos;
-        size_t curPosByte = curBitPos == 8 ? _reader->Tell() : _reader->Tell() - 1;
-        // 1 - 寻找下一个 RBSP 起点 NAL START CODE (0x000003)
+        // Hint : a set bit in the rest of current byte followed by a nonzero byte can not be rbsp_stop_one_bit,
+        //        (the byte holding rbsp_stop_one_bit is the last nonzero byte of NAL unit), decide from the bit cache
+        uint32_t restBits = _cacheBits % 8 ? _cacheBits % 8 : 8;
+        if (_cacheBits < restBits + 8)
         {
-            try 
-            {
-                uint32_t next_24_bits = 0;
-                U(24, next_24_bits, true);
-                while (next_24_bits != 0x000001)
-                {
-                    if ((next_24_bits & 0xFFFF) == 0)
-                    {
-                        Skip(8);
-                    }
-                    else if ((next_24_bits & 0xFF) == 0)
-                    {
-                        Skip(16);
-                    }
-                    else
-                    {
-                        Skip(32);
-                    }
-                    _rbspEndByte = _reader->Tell();
-                    U(24, next_24_bits, true);
-                }
-            }
-            catch (...)
-            {
-                // Hint : nothing to do
-            }
+            FillCache();
         }
-        // 2 - 移除 rbsp_trailing_bits() 后的几个 zero byte (,如果存在的话)
+        if (_cacheBits >= restBits + 8)
         {
-            
-            uint8_t zeroByte = 0;
-            do
+            uint32_t value = (uint32_t)(_cache >> (64 - restBits - 8));
+            if ((value >> 8) != 0 && (value & 0xFF) != 0)
             {
-                U(8, zeroByte, true);
-                if (zeroByte == 0)
-                {
-                    _reader->Seek(_reader->Tell() - 1);
-                    _rbspEndByte = _reader->Tell();
-                }
-            } while (zeroByte == 0);            
-        }
-        _reader->Seek(curPosByte);
-        if (curBitPos != 8)
-        {
-            ReadOneByteAuto(true);
+                return true;
+            }
         }
-        _curBitPos = curBitPos;
-        _inNalUnit = inNalUnit;
-        return more_rbsp_data();
     }
-
-    return true;
+    if (!_rbspStopBitValid) // update _rbspStopBit, once per NAL unit
+    {
+        _rbspStopBit = ScanRbspStopBit();
+        _rbspStopBitValid = true;
+    }
+    return CurBits() < _rbspStopBit;
 }
 
 void H26xBinaryReader::rbsp_trailing_bits()
@@ -364,7 +318,7 @@ void H26xBinaryReader::rbsp_trailing_bits()
     uint8_t rbsp_alignment_zero_bit;
     U(1, rbsp_stop_one_bit);
     assert(rbsp_stop_one_bit == 1);
-    while (!(_curBitPos == 0 || _curBitPos == 8))
+    while (_cacheBits % 8 != 0)
     {
         U(1, rbsp_alignment_zero_bit);
         // assert(rbsp_alignment_zero_bit == 0);
@@ -378,7 +332,7 @@ bool H26xBinaryReader::more_data_in_byte_stream()
     // specified as follows:
     // - If more data follow in the byte stream, the return value of more_data_in_byte_stream( ) is equal to TRUE.
     // - Otherwise, the return value of more_data_in_byte_stream( ) is equal to FALSE.
-    return !_reader->Eof();
+    return !Eof();
 }
 
 void H26xBinaryReader::byte_alignment()
@@ -393,21 +347,91 @@ bool H26xBinaryReader::End()
     return true;
 }
 
-bool H26xBinaryReader::ReadBytes(size_t byte, uint8_t* value)
+uint64_t H26xBinaryReader::ReadBitsSlow(size_t bits)
 {
-    size_t readByte = _reader->Read(value, byte);
-    if (readByte != byte)
+    if (bits == 0)
     {
-        throw std::out_of_range("");
+        return 0;
     }
-    return readByte == byte;
+    else if (bits > 32)
+    {
+        uint64_t high = ReadBits(bits - 32);
+        return (high << 32) | ReadBits(32);
+    }
+    if (_cacheBits < bits)
+    {
+        Refill(bits);
+        if (_cacheBits < bits) // overrun (MMP_H26X_NO_EXCEPTIONS), what is left is padded with zeros
+        {
+            uint64_t value = _cache >> (64 - bits);
+            _cache = 0;
+            _cacheBits = 0;
+            _cacheEscapes = 0;
+            return value;
+        }
+    }
+    uint64_t value = _cache >> (64 - bits);
+    _cache <<= bits;
+    _cacheBits -= (uint32_t)bits;
+    return value;
 }
 
-void H26xBinaryReader::ReadOneByteAuto(bool force)
+uint64_t H26xBinaryReader::PeekBitsSlow(size_t bits)
 {
-    if (_curBitPos == 8 || force)
+    assert(bits <= 32);
+    if (bits == 0)
     {
-        ReadBytes(1, &_curValue);
+        return 0;
+    }
+    if (_cacheBits < bits)
+    {
+        Refill(bits);
+    }
+    return _cache >> (64 - bits);
+}
+
+void H26xBinaryReader::Refill(size_t bits)
+{
+    while (_cacheBits < bits)
+    {
+        uint32_t cacheBits = _cacheBits;
+        FillCache();
+        if (cacheBits == _cacheBits)
+        {
+            _eof = true;
+            MMP_H26X_READER_ERROR(std::out_of_range(std::string()), return);
+        }
+    }
+}
+
+void H26xBinaryReader::FillCache()
+{
+    // Fast path : one unaligned big-endian load, as long as no 0x03 byte is involved
+    if (_dataLen - _dataPos >= 8 && _cacheBits <= 56)
+    {
+        uint64_t word = LoadBE64(_data + _dataPos);
+        uint32_t bytes = (64 - _cacheBits) / 8;
+        uint64_t value = bytes == 8 ? word : word >> (64 - bytes * 8);
+        //  Hint : 0x0000030x -> 0x00000x, only possible when there is a 0x03 byte
+        if (!_inNalUnit || !_escaped || !HasZeroByte(value ^ 0x0303030303030303ULL))
+        {
+            _cache |= (value << (64 - bytes * 8)) >> _cacheBits;
+            _cacheBits += bytes * 8;
+            _cacheEscapes <<= bytes;
+            _dataPos += bytes;
+            _zeroCount = value == 0 ? (_zeroCount + bytes) % 3 : (CountTrailingZero64(value) / 8) % 3;
+            return;
+        }
+    }
+    // Slow path : byte by byte
+    while (_cacheBits <= 56)
+    {
+        uint8_t value = 0;
+        bool    escape = false;
+        if (!FetchByte(value))
+        {
+            break;
+        }
         //  Hint : 0x0000030x -> 0x00000x
         //  The RBSP data is searched for byte-aligned bits of the following binary patterns:
         //  '00000000 00000000 000000xx' (where xx represents any 2 bit pattern: 00, 01, 10, or 11),
@@ -419,12 +443,17 @@ void H26xBinaryReader::ReadOneByteAuto(bool force)
         //  account when searching the RBSP data for the next occurrence of byte-aligned bits with the binary patterns 
         //  specified above.
         //
-        if (_inNalUnit && _zeroCount == 2 && _curValue == 3) 
+        if (_inNalUnit && _escaped && _zeroCount == 2 && value == 3)
         {
-            ReadBytes(1, &_curValue);
+            if (!FetchByte(value))
+            {
+                _dataPos--;
+                break;
+            }
             _zeroCount = 0;
+            escape = true;
         }
-        if (_curValue == 0)
+        if (value == 0)
         {
             _zeroCount = (_zeroCount + 1) % 3;
         }
@@ -432,8 +461,175 @@ void H26xBinaryReader::ReadOneByteAuto(bool force)
         {
             _zeroCount = 0;
         }
-        _curBitPos = 0;
+        _cache |= (uint64_t)value << (56 - _cacheBits);
+        _cacheBits += 8;
+        _cacheEscapes = (_cacheEscapes << 1) | (escape ? 1 : 0);
+    }
+}
+
+bool H26xBinaryReader::FetchByte(uint8_t& value)
+{
+    if (_dataPos == _dataLen && !FetchChunk())
+    {
+        return false;
+    }
+    value = _data[_dataPos++];
+    return true;
+}
+
+bool H26xBinaryReader::FetchChunk()
+{
+    if (!_reader) // contiguous memory, nothing more to read
+    {
+        return false;
+    }
+    if (!_dataBaseValid)
+    {
+        _dataBase = _reader->Tell();
+        _dataBaseValid = true;
+    }
+    if (_buf.empty())
+    {
+        _buf.resize(kKeepBackSize + kChunkSize);
+    }
+    uint8_t keepBack[kKeepBackSize];
+    size_t  keepBackSize = _dataLen < kKeepBackSize ? _dataLen : kKeepBackSize;
+    if (keepBackSize)
+    {
+        memcpy(keepBack, _data + _dataLen - keepBackSize, keepBackSize);
+    }
+    size_t readBytes = _reader->Read(_buf.data() + kKeepBackSize, kChunkSize);
+    if (readBytes == 0)
+    {
+        return false;
+    }
+    memcpy(_buf.data() + kKeepBackSize - keepBackSize, keepBack, keepBackSize);
+    _dataBase = _dataBase + _dataLen - keepBackSize;
+    _data = _buf.data() + kKeepBackSize - keepBackSize;
+    _dataLen = keepBackSize + readBytes;
+    _dataPos = keepBackSize;
+    return true;
+}
+
+void H26xBinaryReader::Rewind(uint64_t bitPos)
+{
+    uint64_t bytePos = bitPos / 8;
+    if (_dataBaseValid && bytePos >= _dataBase && bytePos <= _dataBase + _dataLen)
+    {
+        _dataPos = (size_t)(bytePos - _dataBase);
+    }
+    else if (!_reader) // contiguous memory, beyond the end
+    {
+        // Hint : nothing to seek to, a position past the end sets the sticky error, see also Error()
+        _dataPos = _dataLen;
+        _error = _error || bytePos > _dataBase + _dataLen;
+    }
+    else
+    {
+        _reader->Seek((size_t)bytePos);
+        _data = nullptr;
+        _dataBase = bytePos;
+        _dataBaseValid = true;
+        _dataLen = 0;
+        _dataPos = 0;
+    }
+    _cache = 0;
+    _cacheBits = 0;
+    _cacheEscapes = 0;
+    _eof = false;
+    _zeroCount = 0;
+    for (size_t pos = _dataPos; pos > 0 && _zeroCount < 2 && _data[pos - 1] == 0; pos--)
+    {
+        _zeroCount++;
+    }
+    ReadBits(bitPos % 8);
+}
+
+bool H26xBinaryReader::RawByteAt(uint64_t offset, uint8_t& value)
+{
+    if (_dataBaseValid && offset >= _dataBase && offset < _dataBase + _dataLen)
+    {
+        value = _data[offset - _dataBase];
+        return true;
+    }
+    if (!_reader) // contiguous memory, nothing beyond, probing is not an error
+    {
+        return false;
+    }
+    uint64_t curBits = CurBits();
+    bool inNalUnit = _inNalUnit;
+    _inNalUnit = false;
+    Rewind(offset * 8);
+    bool res = FetchByte(value);
+    _inNalUnit = inNalUnit;
+    Rewind(curBits);
+    return res;
+}
+
+uint64_t H26xBinaryReader::ScanRbspStopBit()
+{
+    if (_nalEndValid)
+    {
+        // Hint : NAL unit size is known, search backward from its end, usually the last byte holds rbsp_stop_one_bit
+        uint64_t curBits = CurBits();
+        uint32_t zeroCount = 0;
+        for (uint64_t offset = _nalEnd; offset * 8 > curBits; offset--)
+        {
+            uint8_t value = 0;
+            if (!RawByteAt(offset - 1, value))
+            {
+                continue;
+            }
+            if (value == 0)
+            {
+                zeroCount++;
+                continue;
+            }
+            uint8_t prev1 = 0xFF, prev2 = 0xFF;
+            if (_escaped && value == 0x03 && zeroCount == 0 && offset >= 3 &&
+                RawByteAt(offset - 2, prev1) && RawByteAt(offset - 3, prev2) && prev1 == 0 && prev2 == 0
+            )
+            {
+                // Hint : 0x03 appended after cabac_zero_word, see also H26xBinaryReader::FillCache
+                continue;
+            }
+            return (offset - 1) * 8 + (7 - CountTrailingZero64(value));
+        }
+        return curBits;
+    }
+    // Hint : 寻找下一个 NAL START CODE (0x000001) 或 trailing_zero_8bits (0x000000),
+    //        根据 ISO 描述, 在 rbsp_trailing_bits() 后可能存在几个字节的 zero, 此部分不算做 RBSP 范畴内,
+    //        rbsp_stop_one_bit 即最后一个非零字节的最低位 1
+    uint64_t curBits = CurBits();
+    uint64_t stopBit = curBits;
+    bool inNalUnit = _inNalUnit;
+    _inNalUnit = false;
+    Rewind(curBits & ~((uint64_t)7));
+    {
+        uint64_t offset = curBits / 8;
+        uint32_t zeroCount = 0;
+        uint8_t  value = 0;
+        while (FetchByte(value))
+        {
+            if (_escaped && zeroCount >= 2 && value <= 1) // Hint : RBSP 中可能出现 0x000000, 此时以数据结尾为准
+            {
+                break;
+            }
+            if (value == 0)
+            {
+                zeroCount++;
+            }
+            else
+            {
+                zeroCount = 0;
+                stopBit = offset * 8 + (7 - CountTrailingZero64(value));
+            }
+            offset++;
+        }
     }
+    _inNalUnit = inNalUnit;
+    Rewind(curBits);
+    return stopBit;
 }
 
 } // namespace Codec
@@ -4,10 +4,17 @@
 // Library: Codec
 // Package: H26x
 // Module:  H26x
-// 
+//
 
 #pragma once
 
+#include <vector>
+#include <cassert>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif /* _MSC_VER */
+
 #include "H264Common.h"
 #include "AbstractH26xByteReader.h"
 
@@ -16,13 +23,34 @@ namespace Mmp
 namespace Codec
 {
 
+/**
+ * @brief bit reader for H264/H265 syntax elements
+ * @note  bits are served from a 64-bit cache, the cache is refilled from a block buffer
+ *        (one unaligned big-endian load when possible) and the block buffer is refilled
+ *        from AbstractH26xByteReader in chunks, emulation prevention (0x000003) is removed
+ *        while refilling the cache when inside a NAL unit.
+ *        Cache hits (the common case) are inlined into the caller, see the end of this file,
+ *        only refilling goes through the out-of-line slow paths.
+ */
 class H26xBinaryReader
 {
 public:
     using ptr = std::shared_ptr<H26xBinaryReader>;
 public:
     explicit H26xBinaryReader(AbstractH26xByteReader::ptr reader);
+    /**
+     * @brief read directly from contiguous memory, such as one NAL unit (without start code)
+     *        or one whole access unit (byte stream format)
+     * @param escaped : false if emulation prevention has been removed already, see also H26xRbspBuffer
+     * @note  no copy is made, data must stay valid while reading
+     */
+    H26xBinaryReader(const uint8_t* data, size_t size, bool escaped = true);
     virtual ~H26xBinaryReader();
+public:
+    /**
+     * @brief rebind to another contiguous memory, see also H26xBinaryReader(const uint8_t* data, size_t size)
+     */
+    void Reset(const uint8_t* data, size_t size, bool escaped = true);
 public:
     void UE(uint32_t& value);
 public:
@@ -41,13 +69,38 @@ public:
     void B8(uint8_t& value);
 public:
     void Skip(size_t bits);
+public:
+    /**
+     * @brief show the next bits (at most 32) without consuming them
+     * @note  served from the bit cache, the byte reader is never seeked
+     */
+    uint32_t ShowBits(size_t bits);
+    /**
+     * @brief consume bits, usually the ones just shown by ShowBits()
+     */
+    void SkipBits(size_t bits);
 public:
     void MoveNextByte();
     bool Eof();
+    /**
+     * @brief sticky error flag, set on overrun or malformed syntax element, cleared by BeginNalUnit() and Reset()
+     * @note  with MMP_H26X_NO_EXCEPTIONS the reader never throws, zeros are returned after an error,
+     *        so callers check the flag at the end of each syntax structure
+     */
+    bool Error();
 public:
+    /**
+     * @brief size of the NAL unit about to begin (start code excluded), valid for the next BeginNalUnit() only
+     * @note  with the size known, more_rbsp_data() searches rbsp_stop_one_bit backward from the end of
+     *        the NAL unit instead of searching for the next start code, and EndNalUnit() jumps to the end directly
+     */
+    void SetNalUnitSize(size_t nalSize);
     void BeginNalUnit();
     void EndNalUnit();
 public:
+    /**
+     * @brief current bit position in the (escaped) byte stream
+     */
     size_t CurBits();
 public:
     bool more_rbsp_data();
@@ -57,20 +110,223 @@ public:
     void byte_alignment();
 public:
     bool End();
-public:
-    void ReadOneByteAuto(bool force = false);
-    bool ReadBytes(size_t byte, uint8_t* value);
 private:
-    uint8_t  _curBitPos;
-    uint8_t  _curValue;
+    uint64_t ReadBits(size_t bits);
+    uint64_t PeekBits(size_t bits);
+    uint64_t ReadBitsSlow(size_t bits);
+    uint64_t PeekBitsSlow(size_t bits);
+    void     UESlow(uint32_t& value);
+    void     SkipSlow(size_t bits);
+    void     BitsOutOfRange();
+    static uint32_t CountLeadingZero64(uint64_t value);
+    void     Refill(size_t bits);
+    void     FillCache();
+    bool     FetchByte(uint8_t& value);
+    bool     FetchChunk();
+    void     Rewind(uint64_t bitPos);
+    bool     RawByteAt(uint64_t offset, uint8_t& value);
+    uint64_t ScanRbspStopBit();
+private:
+    uint64_t _cache;          // left aligned, the MSB is the next bit
+    uint32_t _cacheBits;
+    uint32_t _cacheEscapes;   // bit i set: emulation_prevention_three_byte dropped before i-th newest cached byte
+private:
+    std::vector<uint8_t> _buf;       // block buffer, unused when reading from contiguous memory
+    const uint8_t*       _data;
+    size_t               _dataLen;
+    size_t               _dataPos;
+    uint64_t             _dataBase; // byte stream offset of _data[0]
+    bool                 _dataBaseValid;
+    bool                 _eof;
 private:
     uint32_t _zeroCount;
-    uint64_t _rbspEndByte;
+    uint64_t _rbspStopBit;
+    bool     _rbspStopBitValid;
+    size_t   _nalSize;
+    bool     _nalSizeValid;
+    uint64_t _nalEnd;         // byte stream offset of the end of current NAL unit
+    bool     _nalEndValid;
 private:
     bool _inNalUnit;
+    bool _escaped;
+    bool _error;
 private:
     AbstractH26xByteReader::ptr _reader;
 };
 
+inline uint32_t H26xBinaryReader::CountLeadingZero64(uint64_t value)
+{
+    assert(value != 0);
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return 63 - (uint32_t)index;
+#else
+    return (uint32_t)__builtin_clzll(value);
+#endif
+}
+
+inline uint64_t H26xBinaryReader::ReadBits(size_t bits)
+{
+    if (bits != 0 && bits <= 32 && bits <= _cacheBits)
+    {
+        uint64_t value = _cache >> (64 - bits);
+        _cache <<= bits;
+        _cacheBits -= (uint32_t)bits;
+        return value;
+    }
+    return ReadBitsSlow(bits);
+}
+
+inline uint64_t H26xBinaryReader::PeekBits(size_t bits)
+{
+    if (bits != 0 && bits <= _cacheBits)
+    {
+        return _cache >> (64 - bits);
+    }
+    return PeekBitsSlow(bits);
+}
+
+inline void H26xBinaryReader::UE(uint32_t& value)
+{
+    // Hint : leadingZeroBits <= 15, the whole code (at most 31 bits) is cached
+    if (_cacheBits >= 32 && (_cache >> 48) != 0)
+    {
+        uint32_t codeBits = 2 * CountLeadingZero64(_cache) + 1;
+        value = (uint32_t)((_cache >> (64 - codeBits)) - 1);
+        _cache <<= codeBits;
+        _cacheBits -= codeBits;
+        return;
+    }
+    UESlow(value);
+}
+
+inline void H26xBinaryReader::SE(int32_t& value)
+{
+    // See also : ISO 14496/10(2020) -  Table 9-3 – Assignment of syntax element to codeNum for signed Exp-Golomb coded syntax elements se(v)}
+    uint32_t codeNum = 0;
+    UE(codeNum);
+    if (codeNum % 2 == 0)
+    {
+        value = -(codeNum >> 1);
+    }
+    else
+    {
+        value = (codeNum >> 1) + 1;
+    }
+}
+
+#define MMP_U_OPERATION(bits, value, type, maxBits)         if (bits > maxBits)\
+                                                            {\
+                                                                value = 0;\
+                                                                BitsOutOfRange();\
+                                                                return;\
+                                                            }\
+                                                            value = (type)ReadBits(bits);
+
+#define MMP_U_PRED_OPERATION(bits, value, type, maxBits)    if (bits > maxBits)\
+                                                            {\
+                                                                value = 0;\
+                                                                BitsOutOfRange();\
+                                                                return;\
+                                                            }\
+                                                            value = (type)PeekBits(bits);
+
+#define MMP_I_OPERATION(bits, value, type, maxBits)         MMP_U_OPERATION(bits, value, type, maxBits)
+
+inline void H26xBinaryReader::U(size_t bits, uint64_t& value)
+{
+    MMP_U_OPERATION(bits, value, uint64_t, 64);
+}
+
+inline void H26xBinaryReader::U(size_t bits, uint32_t& value, bool probe)
+{
+    if (!probe)
+    {
+        MMP_U_OPERATION(bits, value, uint32_t, 32);
+    }
+    else
+    {
+        MMP_U_PRED_OPERATION(bits, value, uint32_t, 32);
+    }
+}
+
+inline void H26xBinaryReader::U(size_t bits, uint16_t& value)
+{
+    MMP_U_OPERATION(bits, value, uint16_t, 16);
+}
+
+inline void H26xBinaryReader::U(size_t bits, uint8_t& value, bool probe)
+{
+    if (!probe)
+    {
+        MMP_U_OPERATION(bits, value, uint8_t, 8);
+    }
+    else
+    {
+        MMP_U_PRED_OPERATION(bits, value, uint8_t, 8);
+    }
+}
+
+inline void H26xBinaryReader::I(size_t bits, int64_t& value)
+{
+    MMP_I_OPERATION(bits, value, int64_t, 64);
+}
+
+inline void H26xBinaryReader::I(size_t bits, int32_t& value)
+{
+    MMP_I_OPERATION(bits, value, int32_t, 32);
+}
+
+inline void H26xBinaryReader::I(size_t bits, int16_t& value)
+{
+    MMP_I_OPERATION(bits, value, int16_t, 16);
+}
+
+inline void H26xBinaryReader::I(size_t bits, int8_t& value)
+{
+    MMP_I_OPERATION(bits, value, int8_t, 8);
+}
+
+#undef MMP_I_OPERATION
+#undef MMP_U_PRED_OPERATION
+#undef MMP_U_OPERATION
+
+inline void H26xBinaryReader::B8(uint8_t& value)
+{
+    U(8, value);
+}
+
+inline void H26xBinaryReader::Skip(size_t bits)
+{
+    if (bits <= _cacheBits) // 不需要重新填充缓存
+    {
+        _cache = bits == 64 ? 0 : _cache << bits;
+        _cacheBits -= (uint32_t)bits;
+        return;
+    }
+    SkipSlow(bits);
+}
+
+inline uint32_t H26xBinaryReader::ShowBits(size_t bits)
+{
+    if (bits > 32)
+    {
+        BitsOutOfRange();
+        return 0;
+    }
+    return (uint32_t)PeekBits(bits);
+}
+
+inline void H26xBinaryReader::SkipBits(size_t bits)
+{
+    Skip(bits);
+}
+
+inline void H26xBinaryReader::MoveNextByte()
+{
+    Skip(_cacheBits % 8);
+}
+
 } // namespace Codec
 } // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "H26xByteStreamFeeder.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xByteStreamFeeder::H26xByteStreamFeeder(const NalUnitCallback& callback)
+{
+    _callback = callback;
+    _pendingBase = 0;
+    _pos = 0;
+}
+
+void H26xByteStreamFeeder::Feed(const uint8_t* data, size_t size)
+{
+    uint64_t chunkBase = _pos;
+    _nals.clear();
+    _splitter.Push(data, size, _nals);
+    _pos += size;
+    for (const H26xNalUnitInfo& nal : _nals)
+    {
+        if (nal.offset >= chunkBase)
+        {
+            _callback(data + (nal.offset - chunkBase), nal.size);
+        }
+        else
+        {
+            // Hint : only the first NAL unit may begin in a previous chunk, complete it in _pending
+            uint64_t end = nal.offset + nal.size;
+            if (end > chunkBase)
+            {
+                _pending.insert(_pending.end(), data, data + (end - chunkBase));
+            }
+            _callback(_pending.data() + (nal.offset - _pendingBase), nal.size);
+        }
+    }
+    // Hint : keep what the unfinished NAL unit has got so far
+    uint64_t keep = _splitter.PendingOffset();
+    if (keep >= chunkBase)
+    {
+        _pending.assign(data + (keep - chunkBase), data + size);
+    }
+    else
+    {
+        if (!_nals.empty()) // restore what has been appended for the completed NAL unit
+        {
+            _pending.resize((size_t)(chunkBase - _pendingBase));
+        }
+        _pending.erase(_pending.begin(), _pending.begin() + (size_t)(keep - _pendingBase));
+        _pending.insert(_pending.end(), data, data + size);
+    }
+    _pendingBase = keep;
+}
+
+void H26xByteStreamFeeder::Flush()
+{
+    _nals.clear();
+    _splitter.Flush(_nals);
+    for (const H26xNalUnitInfo& nal : _nals)
+    {
+        _callback(_pending.data() + (nal.offset - _pendingBase), nal.size);
+    }
+    _pending.clear();
+    _pendingBase = _pos;
+}
+
+void H26xByteStreamFeeder::Reset()
+{
+    _splitter.Reset();
+    _nals.clear();
+    _pending.clear();
+    _pendingBase = 0;
+    _pos = 0;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
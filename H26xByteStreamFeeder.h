@@ -0,0 +1,60 @@
+//
+// H26xByteStreamFeeder.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+#include "H26xNalSplitter.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief push mode byte stream (Annex B) input, chunks of any size in, complete NAL units out
+ * @note  1 - NAL units lying inside one chunk are reported in place (no copy),
+ *            only the unfinished tail of a chunk is buffered until its NAL unit completes
+ *        2 - a NAL unit is complete once the next start code arrives, or on Flush()
+ *        3 - data passed to the callback is only valid during the call
+ */
+class H26xByteStreamFeeder
+{
+public:
+    using ptr = std::shared_ptr<H26xByteStreamFeeder>;
+    /**
+     * @param data : NAL unit (start code and trailing_zero_8bits excluded)
+     * @param size
+     */
+    using NalUnitCallback = std::function<void(const uint8_t* data, size_t size)>;
+public:
+    explicit H26xByteStreamFeeder(const NalUnitCallback& callback);
+    ~H26xByteStreamFeeder() = default;
+public:
+    void Feed(const uint8_t* data, size_t size);
+    /**
+     * @brief end of byte stream, the last NAL unit (if any) is reported
+     */
+    void Flush();
+    void Reset();
+private:
+    NalUnitCallback              _callback;
+    H26xNalSplitter              _splitter;
+    std::vector<H26xNalUnitInfo> _nals;
+private:
+    std::vector<uint8_t> _pending;
+    uint64_t             _pendingBase; // byte stream offset of _pending[0]
+    uint64_t             _pos;         // byte stream offset of the next byte fed
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "H26xMmapByteReader.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif /* _WIN32 */
+
+#include "H26xUltis.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xMmapByteReader::H26xMmapByteReader(const std::string& path, size_t readAheadWindow, bool hugePage)
+{
+    _isOpen = false;
+    _data = nullptr;
+    _size = 0;
+    _pos = 0;
+    _eof = false;
+    _readAheadWindow = readAheadWindow;
+    _readAheadBegin = 0;
+    _readAheadEnd = 0;
+    _pageSize = 4096;
+#ifdef _WIN32
+    (void)hugePage; // Hint : large pages are not available for file mapping on Windows
+    _mapping = nullptr;
+    _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (_file == INVALID_HANDLE_VALUE)
+    {
+        H26x_LOG_ERROR << "[H26x] open " << path << " fail" << H26x_LOG_TERMINATOR;
+        _file = nullptr;
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(_file, &fileSize))
+    {
+        H26x_LOG_ERROR << "[H26x] get size of " << path << " fail" << H26x_LOG_TERMINATOR;
+        return;
+    }
+    _size = (size_t)fileSize.QuadPart;
+    if (_size)
+    {
+        _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!_mapping)
+        {
+            H26x_LOG_ERROR << "[H26x] map " << path << " fail" << H26x_LOG_TERMINATOR;
+            _size = 0;
+            return;
+        }
+        _data = (uint8_t*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!_data)
+        {
+            H26x_LOG_ERROR << "[H26x] map " << path << " fail" << H26x_LOG_TERMINATOR;
+            _size = 0;
+            return;
+        }
+    }
+#else
+    _pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    _fd = open(path.c_str(), O_RDONLY);
+    if (_fd < 0)
+    {
+        H26x_LOG_ERROR << "[H26x] open " << path << " fail" << H26x_LOG_TERMINATOR;
+        return;
+    }
+    struct stat st;
+    if (fstat(_fd, &st) != 0)
+    {
+        H26x_LOG_ERROR << "[H26x] stat " << path << " fail" << H26x_LOG_TERMINATOR;
+        return;
+    }
+    _size = (size_t)st.st_size;
+    if (_size)
+    {
+        void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (data == MAP_FAILED)
+        {
+            H26x_LOG_ERROR << "[H26x] mmap " << path << " fail" << H26x_LOG_TERMINATOR;
+            _size = 0;
+            return;
+        }
+        _data = (uint8_t*)data;
+        madvise(_data, _size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+        if (hugePage)
+        {
+            madvise(_data, _size, MADV_HUGEPAGE);
+        }
+#else
+        (void)hugePage;
+#endif /* MADV_HUGEPAGE */
+    }
+#endif /* _WIN32 */
+    _isOpen = true;
+    ReadAhead();
+}
+
+H26xMmapByteReader::~H26xMmapByteReader()
+{
+#ifdef _WIN32
+    if (_data)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping)
+    {
+        CloseHandle(_mapping);
+    }
+    if (_file)
+    {
+        CloseHandle(_file);
+    }
+#else
+    if (_data)
+    {
+        munmap(_data, _size);
+    }
+    if (_fd >= 0)
+    {
+        close(_fd);
+    }
+#endif /* _WIN32 */
+}
+
+bool H26xMmapByteReader::IsOpen()
+{
+    return _isOpen;
+}
+
+const uint8_t* H26xMmapByteReader::Data()
+{
+    return _data;
+}
+
+size_t H26xMmapByteReader::Size()
+{
+    return _size;
+}
+
+size_t H26xMmapByteReader::Read(void* data, size_t bytes)
+{
+    size_t readBytes = _size - _pos < bytes ? _size - _pos : bytes;
+    if (readBytes)
+    {
+        memcpy(data, _data + _pos, readBytes);
+        _pos += readBytes;
+        ReadAhead();
+    }
+    if (readBytes < bytes)
+    {
+        _eof = true;
+    }
+    return readBytes;
+}
+
+bool H26xMmapByteReader::Seek(size_t offset)
+{
+    _eof = false;
+    if (offset > _size)
+    {
+        _pos = _size;
+        return false;
+    }
+    _pos = offset;
+    ReadAhead();
+    return true;
+}
+
+size_t H26xMmapByteReader::Tell()
+{
+    return _pos;
+}
+
+bool H26xMmapByteReader::Eof()
+{
+    return _eof || !_isOpen;
+}
+
+void H26xMmapByteReader::ReadAhead()
+{
+    // Hint : advise the next window once half of the current one is consumed (or after seeking out of it)
+    if (!_data || _readAheadWindow == 0)
+    {
+        return;
+    }
+    if (_pos >= _readAheadBegin && (_pos + _readAheadWindow / 2 < _readAheadEnd || _readAheadEnd == _size))
+    {
+        return;
+    }
+    size_t begin = _pos & ~(_pageSize - 1);
+    size_t end = _pos + _readAheadWindow < _size ? _pos + _readAheadWindow : _size;
+#ifndef _WIN32
+    madvise(_data + begin, end - begin, MADV_WILLNEED);
+#endif /* _WIN32 */ // Hint : Windows relies on FILE_FLAG_SEQUENTIAL_SCAN
+    _readAheadBegin = begin;
+    _readAheadEnd = end;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
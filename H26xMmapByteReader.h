@@ -0,0 +1,72 @@
+//
+// H26xMmapByteReader.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <string>
+
+#include "AbstractH26xByteReader.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief AbstractH26xByteReader implemention based on memory mapped file
+ * @note  1 - the whole file is mapped read only, Seek() costs nothing
+ *        2 - the mapping is advised as sequential, and the window in front of the read position
+ *            is advised as will-need (madvise), so that the kernel reads ahead
+ *        3 - Data()/Size() expose the mapping, for zero copy parsing use
+ *            H26xBinaryReader(Data(), Size()) instead of H26xBinaryReader(reader)
+ */
+class H26xMmapByteReader : public AbstractH26xByteReader
+{
+public:
+    using ptr = std::shared_ptr<H26xMmapByteReader>;
+public:
+    /**
+     * @param[in] path
+     * @param[in] readAheadWindow : bytes advised as will-need in front of the read position, 0 to disable
+     * @param[in] hugePage : ask for transparent huge pages (best effort, depends on platform and file system)
+     */
+    explicit H26xMmapByteReader(const std::string& path, size_t readAheadWindow = 8 * 1024 * 1024, bool hugePage = false);
+    ~H26xMmapByteReader();
+public:
+    bool IsOpen();
+    const uint8_t* Data();
+    size_t Size();
+public:
+    size_t Read(void* data, size_t bytes) override;
+    bool Seek(size_t offset) override;
+    size_t Tell() override;
+    bool Eof() override;
+private:
+    void ReadAhead();
+private:
+    bool     _isOpen;
+    uint8_t* _data;
+    size_t   _size;
+    size_t   _pos;
+    bool     _eof;
+private:
+    size_t   _readAheadWindow;
+    size_t   _readAheadBegin;
+    size_t   _readAheadEnd;
+    size_t   _pageSize;
+private:
+#ifdef _WIN32
+    void*    _file;
+    void*    _mapping;
+#else
+    int      _fd;
+#endif /* _WIN32 */
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include "H26xNalIndex.h"
+
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <initializer_list>
+
+#include "H26xUltis.h"
+#include "H26xNalSplitter.h"
+#include "H264Deserialize.h"
+#include "H265Deserialize.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+constexpr uint8_t  H26xNalIndexEntry::kKeyframe;
+constexpr uint8_t  H26xNalIndexEntry::kParameterSet;
+constexpr uint8_t  H26xNalIndexEntry::kFirstSliceOfPicture;
+constexpr uint32_t H26xNalIndexEntry::kInvalidEntry;
+constexpr uint8_t  H26xNalIndexEntry::kInvalidId;
+
+constexpr char kNalIndexMagic[8] = { 'H', '2', '6', 'X', 'N', 'I', 'D', 'X' };
+constexpr uint32_t kNalIndexVersion = 1;
+
+/**
+ * @brief header of sidecar index file
+ */
+class H26xNalIndexHeader
+{
+public:
+    char     magic[8];
+    uint32_t version;
+    uint32_t codec;
+    uint32_t entrySize;
+    uint32_t reserved;
+    uint64_t byteStreamSize;
+    uint64_t entryCount;
+    uint64_t keyframeCount;
+};
+
+H26xNalIndex::H26xNalIndex()
+{
+    _codec = CodecType::H264;
+    _byteStreamSize = 0;
+    _entryData = nullptr;
+    _entryCount = 0;
+    _keyframeData = nullptr;
+    _keyframeCount = 0;
+}
+
+H26xNalIndex::ptr H26xNalIndex::Build(CodecType codec, const uint8_t* data, size_t size)
+{
+    H26xNalIndex::ptr index = std::make_shared<H26xNalIndex>();
+    index->_codec = codec;
+    index->_byteStreamSize = size;
+    std::vector<H26xNalUnitInfo> nals;
+    H26xNalSplitter::Split(data, size, nals);
+    std::vector<H26xNalIndexEntry>& entries = index->_entries;
+    entries.reserve(nals.size());
+    // Hint : entry of the last parameter set received for each id, ids are 8 bits at most
+    std::vector<uint32_t> vpsEntries(256, H26xNalIndexEntry::kInvalidEntry);
+    std::vector<uint32_t> spsEntries(256, H26xNalIndexEntry::kInvalidEntry);
+    std::vector<uint32_t> ppsEntries(256, H26xNalIndexEntry::kInvalidEntry);
+    std::vector<uint8_t>  spsVpsIds(256, H26xNalIndexEntry::kInvalidId);
+    auto activate = [&](H26xNalIndexEntry& entry, uint32_t ppsId) -> void
+    {
+        // Hint : parameter sets are activated by the slice, the last ones received before it are in use
+        if (ppsId >= 256 || ppsEntries[ppsId] == H26xNalIndexEntry::kInvalidEntry)
+        {
+            return;
+        }
+        entry.pps_id = (uint8_t)ppsId;
+        entry.ppsEntry = ppsEntries[ppsId];
+        entry.sps_id = entries[entry.ppsEntry].sps_id;
+        if (entry.sps_id == H26xNalIndexEntry::kInvalidId)
+        {
+            return;
+        }
+        entry.spsEntry = spsEntries[entry.sps_id];
+        if (spsVpsIds[entry.sps_id] != H26xNalIndexEntry::kInvalidId)
+        {
+            entry.vpsEntry = vpsEntries[spsVpsIds[entry.sps_id]];
+        }
+    };
+    H264Deserialize::ptr h264Deserialize = codec == CodecType::H264 ? std::make_shared<H264Deserialize>() : nullptr;
+    H265Deserialize::ptr h265Deserialize = codec == CodecType::H265 ? std::make_shared<H265Deserialize>() : nullptr;
+    for (const H26xNalUnitInfo& info : nals)
+    {
+        uint32_t n = (uint32_t)entries.size();
+        H26xNalIndexEntry entry;
+        memset(&entry, 0, sizeof(H26xNalIndexEntry));
+        entry.offset = info.offset;
+        entry.size = (uint32_t)info.size;
+        entry.vpsEntry = H26xNalIndexEntry::kInvalidEntry;
+        entry.spsEntry = H26xNalIndexEntry::kInvalidEntry;
+        entry.ppsEntry = H26xNalIndexEntry::kInvalidEntry;
+        entry.sps_id = H26xNalIndexEntry::kInvalidId;
+        entry.pps_id = H26xNalIndexEntry::kInvalidId;
+        if (codec == CodecType::H264)
+        {
+            entry.nal_unit_type = info.header & 0x1F;
+            // Hint : other NAL unit types need no deserializing for the index
+            if (entry.nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SPS || entry.nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_PPS ||
+                entry.nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SLICE || entry.nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_IDR)
+            {
+                H264NalSyntax::ptr nal = std::make_shared<H264NalSyntax>();
+                if (h264Deserialize->DeserializeNalSyntax(data + info.offset, info.size, nal))
+                {
+                    if (nal->sps && nal->sps->seq_parameter_set_id < 256)
+                    {
+                        entry.flags |= H26xNalIndexEntry::kParameterSet;
+                        entry.sps_id = (uint8_t)nal->sps->seq_parameter_set_id;
+                        spsEntries[entry.sps_id] = n;
+                    }
+                    else if (nal->pps && nal->pps->pic_parameter_set_id < 256 && nal->pps->seq_parameter_set_id < 256)
+                    {
+                        entry.flags |= H26xNalIndexEntry::kParameterSet;
+                        entry.pps_id = (uint8_t)nal->pps->pic_parameter_set_id;
+                        entry.sps_id = (uint8_t)nal->pps->seq_parameter_set_id;
+                        ppsEntries[entry.pps_id] = n;
+                    }
+                    else if (nal->slice)
+                    {
+                        activate(entry, nal->slice->pic_parameter_set_id);
+                        entry.frame_num = (uint32_t)nal->slice->frame_num;
+                        entry.pic_order_cnt_lsb = nal->slice->pic_order_cnt_lsb;
+                        entry.flags |= nal->slice->first_mb_in_slice == 0 ? H26xNalIndexEntry::kFirstSliceOfPicture : 0;
+                        entry.flags |= entry.nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_IDR ? H26xNalIndexEntry::kKeyframe : 0;
+                    }
+                }
+            }
+        }
+        else
+        {
+            entry.nal_unit_type = (info.header >> 1) & 0x3F;
+            if (entry.nal_unit_type <= H265NaluType::MMP_H265_NALU_TYPE_RSV_IRAP_VCL23 || entry.nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT ||
+                entry.nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT || entry.nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_PPS_NUT)
+            {
+                H265NalSyntax::ptr nal = std::make_shared<H265NalSyntax>();
+                if (h265Deserialize->DeserializeNalSyntax(data + info.offset, info.size, nal))
+                {
+                    if (nal->vps)
+                    {
+                        entry.flags |= H26xNalIndexEntry::kParameterSet;
+                        vpsEntries[nal->vps->vps_video_parameter_set_id] = n;
+                    }
+                    else if (nal->sps && nal->sps->sps_seq_parameter_set_id < 256)
+                    {
+                        entry.flags |= H26xNalIndexEntry::kParameterSet;
+                        entry.sps_id = (uint8_t)nal->sps->sps_seq_parameter_set_id;
+                        entry.vpsEntry = vpsEntries[nal->sps->sps_video_parameter_set_id];
+                        spsEntries[entry.sps_id] = n;
+                        spsVpsIds[entry.sps_id] = nal->sps->sps_video_parameter_set_id;
+                    }
+                    else if (nal->pps && nal->pps->pps_pic_parameter_set_id < 256 && nal->pps->pps_seq_parameter_set_id < 256)
+                    {
+                        entry.flags |= H26xNalIndexEntry::kParameterSet;
+                        entry.pps_id = (uint8_t)nal->pps->pps_pic_parameter_set_id;
+                        entry.sps_id = (uint8_t)nal->pps->pps_seq_parameter_set_id;
+                        ppsEntries[entry.pps_id] = n;
+                    }
+                    else if (nal->slice)
+                    {
+                        activate(entry, nal->slice->slice_pic_parameter_set_id);
+                        entry.pic_order_cnt_lsb = nal->slice->slice_pic_order_cnt_lsb;
+                        entry.flags |= nal->slice->first_slice_segment_in_pic_flag ? H26xNalIndexEntry::kFirstSliceOfPicture : 0;
+                        entry.flags |= entry.nal_unit_type >= H265NaluType::MMP_H265_NALU_TYPE_BLA_W_LP ? H26xNalIndexEntry::kKeyframe : 0;
+                    }
+                }
+            }
+        }
+        if ((entry.flags & H26xNalIndexEntry::kKeyframe) && (entry.flags & H26xNalIndexEntry::kFirstSliceOfPicture))
+        {
+            index->_keyframes.push_back(n);
+        }
+        entries.push_back(entry);
+    }
+    index->_entryData = entries.data();
+    index->_entryCount = entries.size();
+    index->_keyframeData = index->_keyframes.data();
+    index->_keyframeCount = index->_keyframes.size();
+    return index;
+}
+
+H26xNalIndex::ptr H26xNalIndex::Load(const std::string& path)
+{
+    H26xMmapByteReader::ptr mapping = std::make_shared<H26xMmapByteReader>(path, 0);
+    if (!mapping->IsOpen() || mapping->Size() < sizeof(H26xNalIndexHeader))
+    {
+        return nullptr;
+    }
+    const H26xNalIndexHeader* header = (const H26xNalIndexHeader*)mapping->Data();
+    if (memcmp(header->magic, kNalIndexMagic, sizeof(kNalIndexMagic)) != 0 || header->version != kNalIndexVersion ||
+        header->entrySize != sizeof(H26xNalIndexEntry) || (header->codec != (uint32_t)CodecType::H264 && header->codec != (uint32_t)CodecType::H265))
+    {
+        H26x_LOG_ERROR << "[H26x] " << path << " is not a NAL unit index (or of another version)" << H26x_LOG_TERMINATOR;
+        return nullptr;
+    }
+    // Hint : the sidecar is untrusted, counts are checked by division against the remaining bytes so that nothing wraps
+    uint64_t remaining = mapping->Size() - sizeof(H26xNalIndexHeader);
+    if (header->entryCount > remaining / sizeof(H26xNalIndexEntry))
+    {
+        H26x_LOG_ERROR << "[H26x] " << path << " is truncated" << H26x_LOG_TERMINATOR;
+        return nullptr;
+    }
+    remaining -= header->entryCount * sizeof(H26xNalIndexEntry);
+    if (header->keyframeCount > remaining / sizeof(uint32_t) || header->keyframeCount * sizeof(uint32_t) != remaining)
+    {
+        H26x_LOG_ERROR << "[H26x] " << path << " is truncated" << H26x_LOG_TERMINATOR;
+        return nullptr;
+    }
+    const uint32_t* keyframes = (const uint32_t*)(mapping->Data() + sizeof(H26xNalIndexHeader) + header->entryCount * sizeof(H26xNalIndexEntry));
+    for (uint64_t i=0; i<header->keyframeCount; i++)
+    {
+        if (keyframes[i] >= header->entryCount)
+        {
+            H26x_LOG_ERROR << "[H26x] " << path << " keyframe " << keyframes[i] << " out of range" << H26x_LOG_TERMINATOR;
+            return nullptr;
+        }
+    }
+    H26xNalIndex::ptr index = std::make_shared<H26xNalIndex>();
+    index->_codec = (CodecType)header->codec;
+    index->_byteStreamSize = header->byteStreamSize;
+    index->_entryData = (const H26xNalIndexEntry*)(mapping->Data() + sizeof(H26xNalIndexHeader));
+    index->_entryCount = (size_t)header->entryCount;
+    index->_keyframeData = keyframes;
+    index->_keyframeCount = (size_t)header->keyframeCount;
+    index->_mapping = mapping;
+    return index;
+}
+
+bool H26xNalIndex::Save(const std::string& path)
+{
+    H26xNalIndexHeader header;
+    memset(&header, 0, sizeof(H26xNalIndexHeader));
+    memcpy(header.magic, kNalIndexMagic, sizeof(kNalIndexMagic));
+    header.version = kNalIndexVersion;
+    header.codec = (uint32_t)_codec;
+    header.entrySize = sizeof(H26xNalIndexEntry);
+    header.byteStreamSize = _byteStreamSize;
+    header.entryCount = _entryCount;
+    header.keyframeCount = _keyframeCount;
+    std::ofstream ofs(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open())
+    {
+        H26x_LOG_ERROR << "[H26x] open " << path << " fail" << H26x_LOG_TERMINATOR;
+        return false;
+    }
+    ofs.write((const char*)&header, sizeof(H26xNalIndexHeader));
+    ofs.write((const char*)_entryData, (std::streamsize)(_entryCount * sizeof(H26xNalIndexEntry)));
+    ofs.write((const char*)_keyframeData, (std::streamsize)(_keyframeCount * sizeof(uint32_t)));
+    return ofs.good();
+}
+
+H26xNalIndex::CodecType H26xNalIndex::GetCodec()
+{
+    return _codec;
+}
+
+uint64_t H26xNalIndex::ByteStreamSize()
+{
+    return _byteStreamSize;
+}
+
+size_t H26xNalIndex::Count()
+{
+    return _entryCount;
+}
+
+const H26xNalIndexEntry* H26xNalIndex::Entries()
+{
+    return _entryData;
+}
+
+size_t H26xNalIndex::KeyframeCount()
+{
+    return _keyframeCount;
+}
+
+const uint32_t* H26xNalIndex::Keyframes()
+{
+    return _keyframeData;
+}
+
+uint32_t H26xNalIndex::FindKeyframe(uint64_t offset)
+{
+    const uint32_t* end = _keyframeData + _keyframeCount;
+    const uint32_t* it = std::upper_bound(_keyframeData, end, offset, [this](uint64_t offset, uint32_t entry) -> bool
+    {
+        return offset < _entryData[entry].offset;
+    });
+    return it == _keyframeData ? H26xNalIndexEntry::kInvalidEntry : *(it - 1);
+}
+
+void H26xNalIndex::ParameterSets(uint32_t entry, std::vector<uint32_t>& entries)
+{
+    if (entry >= _entryCount)
+    {
+        return;
+    }
+    const H26xNalIndexEntry& e = _entryData[entry];
+    for (uint32_t parameterSet : { e.vpsEntry, e.spsEntry, e.ppsEntry })
+    {
+        if (parameterSet != H26xNalIndexEntry::kInvalidEntry && parameterSet < _entryCount)
+        {
+            entries.push_back(parameterSet);
+        }
+    }
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,115 @@
+//
+// H26xNalIndex.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "H26xMmapByteReader.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief one NAL unit of a byte stream (Annex B), fixed size record of the sidecar index file
+ */
+class H26xNalIndexEntry
+{
+public:
+    static constexpr uint8_t  kKeyframe            = 1 << 0U; // H264 : IDR, H265 : IRAP
+    static constexpr uint8_t  kParameterSet        = 1 << 1U; // H264 : SPS/PPS, H265 : VPS/SPS/PPS
+    static constexpr uint8_t  kFirstSliceOfPicture = 1 << 2U;
+    static constexpr uint32_t kInvalidEntry        = 0xFFFFFFFF;
+    static constexpr uint8_t  kInvalidId           = 0xFF;
+public:
+    uint64_t offset;            // byte stream offset of the NAL unit (start code excluded)
+    uint32_t size;
+    uint32_t vpsEntry;          // entry of the VPS (H265) in use by this slice, kInvalidEntry if none
+    uint32_t spsEntry;          // entry of the SPS in use by this slice, kInvalidEntry if none
+    uint32_t ppsEntry;          // entry of the PPS in use by this slice, kInvalidEntry if none
+    uint32_t frame_num;         // H264 only
+    uint32_t pic_order_cnt_lsb;
+    uint8_t  nal_unit_type;
+    uint8_t  flags;
+    uint8_t  sps_id;            // SPS in use by (slice), or carried by (SPS/PPS), kInvalidId if none
+    uint8_t  pps_id;            // PPS in use by (slice), or carried by (PPS), kInvalidId if none
+    uint32_t reserved;
+};
+
+/**
+ * @brief NAL unit index of a byte stream (Annex B), for random access without linear scan
+ * @note  1 - built in one pass, start codes are located by H26xNalSplitter, only parameter sets and
+ *            slice headers are deserialized
+ *        2 - the sidecar file is the header followed by the entries and the keyframe table (entry numbers),
+ *            all in native (little endian) byte order; Load() maps it, nothing is copied or parsed
+ *        3 - to start decoding at a keyframe, deserialize ParameterSets() of its entry then the keyframe
+ */
+class H26xNalIndex
+{
+public:
+    using ptr = std::shared_ptr<H26xNalIndex>;
+    enum class CodecType : uint32_t
+    {
+        H264 = 264,
+        H265 = 265
+    };
+public:
+    H26xNalIndex();
+    ~H26xNalIndex() = default;
+public:
+    /**
+     * @brief index a whole byte stream held in memory, see also H26xMmapByteReader::Data()
+     */
+    static H26xNalIndex::ptr Build(CodecType codec, const uint8_t* data, size_t size);
+    /**
+     * @brief map a sidecar index file written by Save(), nullptr if missing or invalid
+     */
+    static H26xNalIndex::ptr Load(const std::string& path);
+    bool Save(const std::string& path);
+public:
+    CodecType GetCodec();
+    /**
+     * @brief size of the indexed byte stream, a sidecar index is stale if it differs from the file
+     */
+    uint64_t ByteStreamSize();
+    size_t Count();
+    const H26xNalIndexEntry* Entries();
+    size_t KeyframeCount();
+    /**
+     * @brief entry numbers of keyframes, in stream order
+     */
+    const uint32_t* Keyframes();
+public:
+    /**
+     * @brief entry number of the last keyframe at or before the byte stream offset,
+     *        kInvalidEntry if none (binary search)
+     */
+    uint32_t FindKeyframe(uint64_t offset);
+    /**
+     * @brief entry numbers of the parameter sets (VPS, SPS, PPS) in use by the entry
+     */
+    void ParameterSets(uint32_t entry, std::vector<uint32_t>& entries);
+private:
+    CodecType                      _codec;
+    uint64_t                       _byteStreamSize;
+    std::vector<H26xNalIndexEntry> _entries;   // built
+    std::vector<uint32_t>          _keyframes; // built
+    H26xMmapByteReader::ptr        _mapping;   // loaded
+    const H26xNalIndexEntry*       _entryData;
+    size_t                         _entryCount;
+    const uint32_t*                _keyframeData;
+    size_t                         _keyframeCount;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
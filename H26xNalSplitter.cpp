@@ -0,0 +1,123 @@
+#include "H26xNalSplitter.h"
+
+#include "H26xUltis.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xNalSplitter::H26xNalSplitter()
+{
+    Reset();
+}
+
+void H26xNalSplitter::Split(const uint8_t* data, size_t size, std::vector<H26xNalUnitInfo>& nals)
+{
+    H26xNalSplitter splitter;
+    splitter.Push(data, size, nals);
+    splitter.Flush(nals);
+}
+
+void H26xNalSplitter::Push(const uint8_t* data, size_t size, std::vector<H26xNalUnitInfo>& nals)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    if (_headerPending)
+    {
+        _nal.header = data[0];
+        _headerPending = false;
+    }
+    // Hint : start code across chunk boundary, 0x00 0x00 | 0x01 or 0x00 | 0x00 0x01
+    if (data[0] == 0x01 && _zeroCount >= 2)
+    {
+        OnStartCode(_pos + 1, _zeroCount, nals);
+    }
+    else if (size >= 2 && data[0] == 0x00 && data[1] == 0x01 && _zeroCount >= 1)
+    {
+        OnStartCode(_pos + 2, _zeroCount + 1, nals);
+    }
+    if (_headerPending && _pos + size > _nal.offset)
+    {
+        _nal.header = data[_nal.offset - _pos];
+        _headerPending = false;
+    }
+    for (size_t pos = H26xFindZeroZeroByte(data, 0, size, 0x01); pos != size; pos = H26xFindZeroZeroByte(data, pos + 3, size, 0x01))
+    {
+        // Hint : leading zero bytes belong to zero_byte or trailing_zero_8bits
+        size_t begin = pos;
+        while (begin > 0 && data[begin - 1] == 0x00)
+        {
+            begin--;
+        }
+        uint64_t zeroCount = (pos - begin) + 2 + (begin == 0 ? _zeroCount : 0);
+        OnStartCode(_pos + pos + 3, zeroCount, nals);
+        if (pos + 3 < size)
+        {
+            _nal.header = data[pos + 3];
+            _headerPending = false;
+        }
+    }
+    {
+        size_t end = size;
+        while (end > 0 && data[end - 1] == 0x00)
+        {
+            end--;
+        }
+        _zeroCount = end == 0 ? _zeroCount + size : size - end;
+    }
+    _pos += size;
+}
+
+void H26xNalSplitter::Flush(std::vector<H26xNalUnitInfo>& nals)
+{
+    if (_inNalUnit)
+    {
+        uint64_t end = _pos - _zeroCount;
+        _nal.size = end > _nal.offset ? (size_t)(end - _nal.offset) : 0;
+        if (_headerPending)
+        {
+            _nal.header = 0;
+        }
+        nals.push_back(_nal);
+    }
+    _inNalUnit = false;
+    _headerPending = false;
+}
+
+void H26xNalSplitter::Reset()
+{
+    _pos = 0;
+    _zeroCount = 0;
+    _inNalUnit = false;
+    _headerPending = false;
+    _nal.offset = 0;
+    _nal.size = 0;
+    _nal.header = 0;
+}
+
+uint64_t H26xNalSplitter::PendingOffset()
+{
+    return _inNalUnit ? _nal.offset : _pos;
+}
+
+void H26xNalSplitter::OnStartCode(uint64_t prefixEnd, uint64_t zeroCount, std::vector<H26xNalUnitInfo>& nals)
+{
+    if (_inNalUnit)
+    {
+        // Hint : the zero run never goes before the NAL unit, the byte before it is 0x01
+        uint64_t end = prefixEnd - 1 - zeroCount;
+        _nal.size = end > _nal.offset ? (size_t)(end - _nal.offset) : 0;
+        nals.push_back(_nal);
+    }
+    _inNalUnit = true;
+    _headerPending = true;
+    _nal.offset = prefixEnd;
+    _nal.size = 0;
+    _nal.header = 0;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,79 @@
+//
+// H26xNalSplitter.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief NAL unit located in a byte stream (Annex B)
+ */
+class H26xNalUnitInfo
+{
+public:
+    uint64_t offset;  // byte stream offset of the first byte of nal_unit_header (just after start code)
+    size_t   size;    // NAL unit size, start code and trailing_zero_8bits excluded
+    uint8_t  header;  // first byte of nal_unit_header, H264 : nal_unit_type = header & 0x1F, H265 : nal_unit_type = (header >> 1) & 0x3F
+};
+
+/**
+ * @brief split a byte stream (Annex B) into NAL units without parsing
+ * @note  1 - start codes (0x000001 and 0x00000001) are searched with SSE2/AVX2 when available,
+ *            see also H26xFindZeroZeroByte
+ *        2 - data may be pushed in chunks of any size, start codes across chunk boundaries are handled,
+ *            NAL units are reported with byte stream offsets, the splitter keeps no copy of data
+ *        3 - the last NAL unit is only known to be complete on Flush()
+ * @sa    ISO 14496/10(2020) - B.1.1 Byte stream NAL unit syntax
+ */
+class H26xNalSplitter
+{
+public:
+    using ptr = std::shared_ptr<H26xNalSplitter>;
+public:
+    H26xNalSplitter();
+    ~H26xNalSplitter() = default;
+public:
+    /**
+     * @brief split a whole byte stream held in memory
+     */
+    static void Split(const uint8_t* data, size_t size, std::vector<H26xNalUnitInfo>& nals);
+public:
+    /**
+     * @param[in]  data : next chunk of byte stream
+     * @param[out] nals : NAL units completed by this chunk are appended
+     */
+    void Push(const uint8_t* data, size_t size, std::vector<H26xNalUnitInfo>& nals);
+    /**
+     * @brief end of byte stream, the pending NAL unit (if any) is appended
+     */
+    void Flush(std::vector<H26xNalUnitInfo>& nals);
+    void Reset();
+    /**
+     * @brief byte stream offset of the NAL unit not completed yet (offset of the next byte if none),
+     *        bytes from there on may still belong to a NAL unit reported later
+     */
+    uint64_t PendingOffset();
+private:
+    void OnStartCode(uint64_t prefixEnd, uint64_t zeroCount, std::vector<H26xNalUnitInfo>& nals);
+private:
+    uint64_t _pos;           // byte stream offset of the next byte pushed
+    uint64_t _zeroCount;     // consecutive zero bytes at the end of data pushed so far
+    bool     _inNalUnit;
+    bool     _headerPending; // start code is the last byte of a chunk
+    H26xNalUnitInfo _nal;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
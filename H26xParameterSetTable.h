@@ -0,0 +1,149 @@
+//
+// H26xParameterSetTable.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include "H26xUltis.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief thread safe intern table of deserialized parameter sets of one kind, keyed by content hash
+ * @note  1 - an entry is the NAL unit a parameter set is deserialized from, the parameter set and
+ *            the parameter set it is deserialized against (PPS against SPS, SPS against VPS)
+ *        2 - the table keeps no parameter set alive, entries no longer referred to are swept
+ *        3 - interned parameter sets are shared by every stream, they shall never be modified
+ * @sa    H264ParameterSetStore, H265ParameterSetStore
+ */
+template <typename T>
+class H26xParameterSetTable
+{
+public:
+    /**
+     * @brief parameter set syntax depends on in the calling stream, such as spsSet[pps->seq_parameter_set_id],
+     *        nullptr if missing
+     */
+    using DependencyOf = std::function<std::shared_ptr<void>(const std::shared_ptr<T>& syntax)>;
+public:
+    H26xParameterSetTable()
+    {
+        _sweepSize = 16;
+    }
+    ~H26xParameterSetTable() = default;
+public:
+    /**
+     * @brief find the parameter set deserialized from data
+     * @param dependencyOf : nullptr if the parameter set depends on no other one
+     * @param psData : [out] interned NAL unit of the parameter set found
+     */
+    std::shared_ptr<T> Find(const uint8_t* data, size_t size, uint64_t hash, const DependencyOf& dependencyOf, H26xParameterSetData::ptr& psData)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        auto range = _entries.equal_range(hash);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            std::shared_ptr<T> syntax = it->second.syntax.lock();
+            if (!syntax || !it->second.data->Equal(data, size, hash))
+            {
+                continue;
+            }
+            if (dependencyOf)
+            {
+                std::shared_ptr<void> dependency = dependencyOf(syntax);
+                if (!dependency || dependency != it->second.dependency.lock())
+                {
+                    continue;
+                }
+            }
+            psData = it->second.data;
+            return syntax;
+        }
+        return nullptr;
+    }
+    /**
+     * @brief intern a parameter set just deserialized
+     * @param psData : NAL unit syntax is deserialized from, [out] the interned one
+     * @param dependency : parameter set syntax is deserialized against, nullptr if none
+     * @return syntax, or the byte identical parameter set interned meanwhile by another stream
+     */
+    std::shared_ptr<T> Intern(H26xParameterSetData::ptr& psData, const std::shared_ptr<T>& syntax, const std::shared_ptr<void>& dependency)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        auto range = _entries.equal_range(psData->hash);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            std::shared_ptr<T> interned = it->second.syntax.lock();
+            if (interned && dependency == it->second.dependency.lock() && it->second.data->Equal(psData->data.data(), psData->data.size(), psData->hash))
+            {
+                psData = it->second.data;
+                return interned;
+            }
+        }
+        Sweep();
+        Entry entry;
+        entry.data = psData;
+        entry.syntax = syntax;
+        entry.dependency = dependency;
+        _entries.emplace(psData->hash, entry);
+        return syntax;
+    }
+    /**
+     * @brief entries, including those not swept yet
+     */
+    size_t Size()
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        return _entries.size();
+    }
+private:
+    void Sweep()
+    {
+        // Hint : once the table has doubled since the last sweep, amortized O(1) per insertion
+        if (_entries.size() < _sweepSize)
+        {
+            return;
+        }
+        for (auto it = _entries.begin(); it != _entries.end();)
+        {
+            if (it->second.syntax.expired())
+            {
+                it = _entries.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+        _sweepSize = std::max<size_t>(16, _entries.size() * 2);
+    }
+private:
+    class Entry
+    {
+    public:
+        H26xParameterSetData::ptr data;
+        std::weak_ptr<T>          syntax;
+        std::weak_ptr<void>       dependency;
+    };
+private:
+    std::mutex                                _mtx;
+    std::unordered_multimap<uint64_t, Entry>  _entries;
+    size_t                                    _sweepSize;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
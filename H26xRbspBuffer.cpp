@@ -0,0 +1,92 @@
+#include "H26xRbspBuffer.h"
+
+#include <cstring>
+#include <algorithm>
+
+#include "H26xUltis.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xRbspBuffer::H26xRbspBuffer()
+{
+    _size = 0;
+}
+
+void H26xRbspBuffer::Convert(const uint8_t* data, size_t size)
+{
+    //  Hint : 0x0000030x -> 0x00000x
+    //  See also : H26xBinaryReader::FillCache
+    if (_rbsp.size() < size)
+    {
+        _rbsp.resize(size);
+    }
+    _escapes.clear();
+    size_t src = 0;
+    size_t dst = 0;
+    for (size_t pos = H26xFindZeroZeroByte(data, 0, size, 0x03); pos != size; pos = H26xFindZeroZeroByte(data, src, size, 0x03))
+    {
+        size_t escape = pos + 2;
+        memcpy(_rbsp.data() + dst, data + src, escape - src);
+        dst += escape - src;
+        _escapes.push_back(escape);
+        src = escape + 1;
+    }
+    if (size > src)
+    {
+        memcpy(_rbsp.data() + dst, data + src, size - src);
+        dst += size - src;
+    }
+    _size = dst;
+}
+
+const uint8_t* H26xRbspBuffer::Data() const
+{
+    return _rbsp.data();
+}
+
+size_t H26xRbspBuffer::Size() const
+{
+    return _size;
+}
+
+const std::vector<size_t>& H26xRbspBuffer::EscapePositions() const
+{
+    return _escapes;
+}
+
+size_t H26xRbspBuffer::ToEscapedBitOffset(size_t rbspBitOffset) const
+{
+    // Hint : the k-th escape (0 based) sits right before RBSP byte (_escapes[k] - k)
+    size_t rbspByte = rbspBitOffset / 8;
+    size_t low = 0, high = _escapes.size();
+    while (low < high)
+    {
+        size_t mid = (low + high) / 2;
+        if (_escapes[mid] - mid <= rbspByte)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return rbspBitOffset + low * 8;
+}
+
+size_t H26xRbspBuffer::ToRbspBitOffset(size_t escapedBitOffset) const
+{
+    size_t escapedByte = escapedBitOffset / 8;
+    size_t escapes = std::lower_bound(_escapes.begin(), _escapes.end(), escapedByte) - _escapes.begin();
+    if (escapes < _escapes.size() && _escapes[escapes] == escapedByte) // points to emulation_prevention_three_byte itself
+    {
+        return (escapedByte - escapes) * 8;
+    }
+    return escapedBitOffset - escapes * 8;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
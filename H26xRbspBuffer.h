@@ -0,0 +1,65 @@
+//
+// H26xRbspBuffer.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief convert a whole NAL unit payload into RBSP (remove emulation_prevention_three_byte)
+ * @note  1 - 0x000003 is searched with SSE2/AVX2 when available (scalar otherwise),
+ *            the runs between escapes are block copied
+ *        2 - the buffer is kept across Convert(), reuse one instance per stream to avoid reallocation
+ *        3 - parse the result with H26xBinaryReader(Data(), Size(), false)
+ * @sa    ISO 14496/10(2020) - 7.4.1 NAL unit semantics
+ */
+class H26xRbspBuffer
+{
+public:
+    using ptr = std::shared_ptr<H26xRbspBuffer>;
+public:
+    H26xRbspBuffer();
+    ~H26xRbspBuffer() = default;
+public:
+    /**
+     * @param[in] data : NAL unit (escaped), without start code
+     * @param[in] size
+     */
+    void Convert(const uint8_t* data, size_t size);
+public:
+    const uint8_t* Data() const;
+    size_t Size() const;
+    /**
+     * @brief byte offsets (in the escaped NAL unit) of the removed emulation_prevention_three_byte
+     */
+    const std::vector<size_t>& EscapePositions() const;
+public:
+    /**
+     * @brief map a bit offset of RBSP back to the escaped NAL unit,
+     *        e.g. slice_data_bit_offset parsed from RBSP
+     */
+    size_t ToEscapedBitOffset(size_t rbspBitOffset) const;
+    /**
+     * @brief map a bit offset of the escaped NAL unit to RBSP
+     */
+    size_t ToRbspBitOffset(size_t escapedBitOffset) const;
+private:
+    std::vector<uint8_t> _rbsp;
+    size_t               _size;
+    std::vector<size_t>  _escapes;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
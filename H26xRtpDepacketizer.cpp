@@ -0,0 +1,284 @@
+#include "H26xRtpDepacketizer.h"
+
+#include "H26xUltis.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xRtpDepacketizer::H26xRtpDepacketizer(PayloadFormat format, const NalUnitCallback& callback)
+{
+    _format = format;
+    _callback = callback;
+    _donPresent = false;
+    _seqValid = false;
+    _seq = 0;
+    _inFragment = false;
+}
+
+void H26xRtpDepacketizer::SetLossCallback(const LossCallback& callback)
+{
+    _lossCallback = callback;
+}
+
+void H26xRtpDepacketizer::SetDonPresent(bool donPresent)
+{
+    _donPresent = donPresent;
+}
+
+bool H26xRtpDepacketizer::PushRtpPacket(const uint8_t* packet, size_t size)
+{
+    // See also : RFC 3550 - 5.1 RTP Fixed Header Fields
+    if (size < 12 || (packet[0] >> 6) != 2)
+    {
+        H26x_LOG_ERROR << "[RTP] invalid RTP packet" << H26x_LOG_TERMINATOR;
+        return false;
+    }
+    uint8_t padding = packet[0] & 0x20;
+    uint8_t extension = packet[0] & 0x10;
+    uint8_t csrcCount = packet[0] & 0x0F;
+    uint16_t seq = (uint16_t)((packet[2] << 8) | packet[3]);
+    size_t begin = 12 + csrcCount * 4;
+    size_t end = size;
+    if (extension)
+    {
+        if (begin + 4 > size)
+        {
+            H26x_LOG_ERROR << "[RTP] truncated header extension" << H26x_LOG_TERMINATOR;
+            return false;
+        }
+        begin += 4 + (size_t)((packet[begin + 2] << 8) | packet[begin + 3]) * 4;
+    }
+    if (padding)
+    {
+        end -= packet[size - 1] < end ? packet[size - 1] : end;
+    }
+    if (begin > end)
+    {
+        H26x_LOG_ERROR << "[RTP] invalid RTP packet" << H26x_LOG_TERMINATOR;
+        return false;
+    }
+    return Push(seq, packet + begin, end - begin);
+}
+
+bool H26xRtpDepacketizer::Push(uint16_t seq, const uint8_t* payload, size_t size)
+{
+    if (_seqValid && seq != (uint16_t)(_seq + 1))
+    {
+        uint16_t lostPackets = (uint16_t)(seq - _seq - 1);
+        if (seq == _seq || lostPackets >= 0x8000)
+        {
+            // Hint : duplicated or late packet, its place in the stream has gone
+            return false;
+        }
+        if (_inFragment)
+        {
+            _inFragment = false;
+            _fragment.clear();
+        }
+        if (_lossCallback)
+        {
+            _lossCallback(lostPackets, seq);
+        }
+    }
+    _seqValid = true;
+    _seq = seq;
+    if (size == 0)
+    {
+        return false;
+    }
+    return _format == PayloadFormat::H264 ? PushH264(payload, size) : PushH265(payload, size);
+}
+
+void H26xRtpDepacketizer::Reset()
+{
+    _seqValid = false;
+    _seq = 0;
+    _inFragment = false;
+    _fragment.clear();
+}
+
+bool H26xRtpDepacketizer::PushH264(const uint8_t* payload, size_t size)
+{
+    // See also : RFC 6184 - 5.2 Common Structure of the RTP Payload Format
+    uint8_t type = payload[0] & 0x1F;
+    if (type != 28 /* FU-A */ && type != 29 /* FU-B */ && _inFragment)
+    {
+        H26x_LOG_ERROR << "[RTP] fragmented NAL unit not ended" << H26x_LOG_TERMINATOR;
+        _inFragment = false;
+        _fragment.clear();
+    }
+    switch (type)
+    {
+        case 24: /* STAP-A */
+        {
+            // See also : RFC 6184 - 5.7.1 Single-Time Aggregation Packet (STAP)
+            return DepacketizeAggregation(payload + 1, size - 1, 0, 0, 0);
+        }
+        case 25: /* STAP-B */
+        {
+            return DepacketizeAggregation(payload + 1, size - 1, 2, 0, 0);
+        }
+        case 26: /* MTAP16 */
+        {
+            // See also : RFC 6184 - 5.7.2 Multi-Time Aggregation Packets (MTAPs)
+            return DepacketizeAggregation(payload + 1, size - 1, 2, 0, 3);
+        }
+        case 27: /* MTAP24 */
+        {
+            return DepacketizeAggregation(payload + 1, size - 1, 2, 0, 4);
+        }
+        case 28: /* FU-A */ /* pass through */
+        case 29: /* FU-B */
+        {
+            // See also : RFC 6184 - 5.8 Fragmentation Units (FUs)
+            size_t headerSize = type == 28 ? 2 : 4;
+            if (size < headerSize)
+            {
+                H26x_LOG_ERROR << "[RTP] truncated FU" << H26x_LOG_TERMINATOR;
+                return false;
+            }
+            uint8_t header = (payload[0] & 0xE0) | (payload[1] & 0x1F);
+            return DepacketizeFragment(payload[1] & 0x80, payload[1] & 0x40, &header, 1, payload + headerSize, size - headerSize);
+        }
+        case 0:  /* pass through */
+        case 30: /* pass through */
+        case 31:
+        {
+            H26x_LOG_ERROR << "[RTP] unsupport NAL unit type " << (uint32_t)type << H26x_LOG_TERMINATOR;
+            return false;
+        }
+        default: /* Single NAL Unit Packet */
+        {
+            // See also : RFC 6184 - 5.6 Single NAL Unit Packet
+            _callback(payload, size);
+            return true;
+        }
+    }
+}
+
+bool H26xRtpDepacketizer::PushH265(const uint8_t* payload, size_t size)
+{
+    // See also : RFC 7798 - 4.4 Payload Structures
+    if (size < 2)
+    {
+        H26x_LOG_ERROR << "[RTP] truncated payload header" << H26x_LOG_TERMINATOR;
+        return false;
+    }
+    uint8_t type = (payload[0] >> 1) & 0x3F;
+    if (type != 49 /* FU */ && _inFragment)
+    {
+        H26x_LOG_ERROR << "[RTP] fragmented NAL unit not ended" << H26x_LOG_TERMINATOR;
+        _inFragment = false;
+        _fragment.clear();
+    }
+    switch (type)
+    {
+        case 48: /* AP */
+        {
+            // See also : RFC 7798 - 4.4.2 Aggregation Packets (APs)
+            return DepacketizeAggregation(payload + 2, size - 2, _donPresent ? 2 : 0, _donPresent ? 1 : 0, 0);
+        }
+        case 49: /* FU */
+        {
+            // See also : RFC 7798 - 4.4.3 Fragmentation Units
+            if (size < 3)
+            {
+                H26x_LOG_ERROR << "[RTP] truncated FU" << H26x_LOG_TERMINATOR;
+                return false;
+            }
+            bool start = payload[2] & 0x80;
+            size_t headerSize = start && _donPresent ? 5 : 3;
+            if (size < headerSize)
+            {
+                H26x_LOG_ERROR << "[RTP] truncated FU" << H26x_LOG_TERMINATOR;
+                return false;
+            }
+            uint8_t header[2] = { (uint8_t)((payload[0] & 0x81) | ((payload[2] & 0x3F) << 1)), payload[1] };
+            return DepacketizeFragment(start, payload[2] & 0x40, header, 2, payload + headerSize, size - headerSize);
+        }
+        case 50: /* PACI */
+        {
+            H26x_LOG_ERROR << "[RTP] unsupport PACI packet" << H26x_LOG_TERMINATOR;
+            return false;
+        }
+        default: /* Single NAL Unit Packet */
+        {
+            // See also : RFC 7798 - 4.4.1 Single NAL Unit Packets
+            if (!_donPresent)
+            {
+                _callback(payload, size);
+                return true;
+            }
+            // Hint : DONL sits between NAL unit header and payload, drop it with a copy
+            if (size < 4)
+            {
+                H26x_LOG_ERROR << "[RTP] truncated DONL" << H26x_LOG_TERMINATOR;
+                return false;
+            }
+            _fragment.assign(payload, payload + 2);
+            _fragment.insert(_fragment.end(), payload + 4, payload + size);
+            _callback(_fragment.data(), _fragment.size());
+            _fragment.clear();
+            return true;
+        }
+    }
+}
+
+bool H26xRtpDepacketizer::DepacketizeAggregation(const uint8_t* data, size_t size, size_t firstDonSize, size_t donSize, size_t innerSize)
+{
+    size_t pos = 0;
+    size_t skip = firstDonSize;
+    while (pos < size)
+    {
+        if (size - pos < skip + 2)
+        {
+            H26x_LOG_ERROR << "[RTP] truncated aggregation unit" << H26x_LOG_TERMINATOR;
+            return false;
+        }
+        pos += skip;
+        size_t unitSize = (size_t)((data[pos] << 8) | data[pos + 1]);
+        pos += 2;
+        if (size - pos < unitSize || unitSize <= innerSize)
+        {
+            H26x_LOG_ERROR << "[RTP] invalid aggregation unit size " << unitSize << H26x_LOG_TERMINATOR;
+            return false;
+        }
+        _callback(data + pos + innerSize, unitSize - innerSize);
+        pos += unitSize;
+        skip = donSize;
+    }
+    return true;
+}
+
+bool H26xRtpDepacketizer::DepacketizeFragment(bool start, bool end, const uint8_t* header, size_t headerSize, const uint8_t* data, size_t size)
+{
+    if (start)
+    {
+        if (_inFragment)
+        {
+            H26x_LOG_ERROR << "[RTP] fragmented NAL unit not ended" << H26x_LOG_TERMINATOR;
+        }
+        // Hint : clear() keeps the capacity, the buffer is reused by the next fragmented NAL unit
+        _fragment.clear();
+        _fragment.insert(_fragment.end(), header, header + headerSize);
+        _inFragment = true;
+    }
+    else if (!_inFragment)
+    {
+        // Hint : the first fragment is lost, wait for the next NAL unit
+        return false;
+    }
+    _fragment.insert(_fragment.end(), data, data + size);
+    if (end)
+    {
+        _inFragment = false;
+        _callback(_fragment.data(), _fragment.size());
+        _fragment.clear();
+    }
+    return true;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,100 @@
+//
+// H26xRtpDepacketizer.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief map RTP payloads to NAL units
+ * @note  1 - single NAL unit packets and NAL units within aggregation packets are reported in place (no copy),
+ *            only fragmentation units are reassembled, into a buffer reused from one NAL unit to the next
+ *        2 - NAL units are reported in transmission order, the interleaved packetization mode
+ *            (reordering by decoding order number) is not supported
+ *        3 - a gap of RTP sequence number is reported by the loss callback, the fragmented NAL unit
+ *            in progress is dropped, the parser is expected to resync at the next IDR (H264) or IRAP (H265)
+ *        4 - data passed to the callback is only valid during the call
+ * @sa    RFC 6184 - RTP Payload Format for H.264 Video
+ *        RFC 7798 - RTP Payload Format for High Efficiency Video Coding (HEVC)
+ */
+class H26xRtpDepacketizer
+{
+public:
+    using ptr = std::shared_ptr<H26xRtpDepacketizer>;
+    /**
+     * @param data : NAL unit (without start code)
+     * @param size
+     */
+    using NalUnitCallback = std::function<void(const uint8_t* data, size_t size)>;
+    /**
+     * @param lostPackets : number of packets missing in front of the packet with RTP sequence number seq
+     * @param seq
+     */
+    using LossCallback = std::function<void(uint16_t lostPackets, uint16_t seq)>;
+    enum class PayloadFormat
+    {
+        H264, // RFC 6184
+        H265  // RFC 7798
+    };
+public:
+    H26xRtpDepacketizer(PayloadFormat format, const NalUnitCallback& callback);
+    ~H26xRtpDepacketizer() = default;
+public:
+    void SetLossCallback(const LossCallback& callback);
+    /**
+     * @brief H265 only, DONL/DOND fields are present when sprop-max-don-diff is greater than 0
+     * @sa    RFC 7798 - 7.1 Media Type Registration
+     */
+    void SetDonPresent(bool donPresent);
+public:
+    /**
+     * @brief push one whole RTP packet (RTP header included)
+     * @sa    RFC 3550 - 5.1 RTP Fixed Header Fields
+     */
+    bool PushRtpPacket(const uint8_t* packet, size_t size);
+    /**
+     * @brief push one RTP payload (RTP header and padding removed)
+     * @param seq : RTP sequence number of the packet
+     */
+    bool Push(uint16_t seq, const uint8_t* payload, size_t size);
+    void Reset();
+private:
+    bool PushH264(const uint8_t* payload, size_t size);
+    bool PushH265(const uint8_t* payload, size_t size);
+    /**
+     * @brief aggregation unit : [donSize bytes] + 16 bits size + [innerSize bytes, counted by size] + NAL unit
+     * @param firstDonSize : donSize of the first aggregation unit
+     */
+    bool DepacketizeAggregation(const uint8_t* data, size_t size, size_t firstDonSize, size_t donSize, size_t innerSize);
+    /**
+     * @param header : reconstructed NAL unit header, used on the first fragment only
+     */
+    bool DepacketizeFragment(bool start, bool end, const uint8_t* header, size_t headerSize, const uint8_t* data, size_t size);
+private:
+    PayloadFormat   _format;
+    NalUnitCallback _callback;
+    LossCallback    _lossCallback;
+    bool            _donPresent;
+private:
+    bool     _seqValid;
+    uint16_t _seq;          // RTP sequence number of the last packet
+private:
+    bool                 _inFragment;
+    std::vector<uint8_t> _fragment; // NAL unit being reassembled from fragmentation units
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "H26xThreadPool.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xThreadPool::H26xThreadPool(size_t threadNum)
+{
+    _task = nullptr;
+    _count = 0;
+    _grain = 1;
+    _next = 0;
+    _running = 0;
+    _generation = 0;
+    _quit = false;
+    if (threadNum == 0)
+    {
+        threadNum = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    }
+    for (size_t i=0; i<threadNum; i++)
+    {
+        _threads.emplace_back(&H26xThreadPool::Worker, this, i);
+    }
+}
+
+H26xThreadPool::~H26xThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _quit = true;
+    }
+    _startCond.notify_all();
+    for (std::thread& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+size_t H26xThreadPool::ThreadNum()
+{
+    return _threads.size();
+}
+
+void H26xThreadPool::ParallelFor(size_t count, size_t grain, const Task& task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_mtx);
+    _task = &task;
+    _count = count;
+    _grain = grain ? grain : 1;
+    _next = 0;
+    _running = _threads.size();
+    _generation++;
+    _startCond.notify_all();
+    _doneCond.wait(lock, [this]() { return _running == 0; });
+    _task = nullptr;
+}
+
+void H26xThreadPool::Worker(size_t threadIndex)
+{
+    uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock(_mtx);
+    while (true)
+    {
+        _startCond.wait(lock, [this, generation]() { return _quit || _generation != generation; });
+        if (_quit)
+        {
+            break;
+        }
+        generation = _generation;
+        const Task* task = _task;
+        size_t count = _count;
+        size_t grain = _grain;
+        lock.unlock();
+        for (size_t begin = _next.fetch_add(grain); begin < count; begin = _next.fetch_add(grain))
+        {
+            (*task)(threadIndex, begin, begin + grain < count ? begin + grain : count);
+        }
+        lock.lock();
+        if (--_running == 0)
+        {
+            _doneCond.notify_one();
+        }
+    }
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,69 @@
+//
+// H26xThreadPool.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief fixed size thread pool running data parallel loops
+ * @note  1 - threads are created once and sleep between loops
+ *        2 - ParallelFor() shall not be called concurrently
+ */
+class H26xThreadPool
+{
+public:
+    using ptr = std::shared_ptr<H26xThreadPool>;
+    /**
+     * @param threadIndex : index of the pool thread running the task, in [0, ThreadNum())
+     * @param begin
+     * @param end
+     */
+    using Task = std::function<void(size_t threadIndex, size_t begin, size_t end)>;
+public:
+    /**
+     * @param threadNum : 0 for std::thread::hardware_concurrency()
+     */
+    explicit H26xThreadPool(size_t threadNum = 0);
+    ~H26xThreadPool();
+public:
+    size_t ThreadNum();
+    /**
+     * @brief run task over [0, count), blocks until done
+     * @param grain : indexes are handed out to threads in batches of grain (atomic counter, no static partition)
+     */
+    void ParallelFor(size_t count, size_t grain, const Task& task);
+private:
+    void Worker(size_t threadIndex);
+private:
+    std::vector<std::thread> _threads;
+    std::mutex               _mtx;
+    std::condition_variable  _startCond;
+    std::condition_variable  _doneCond;
+    const Task*              _task;
+    size_t                   _count;
+    size_t                   _grain;
+    std::atomic<size_t>      _next;
+    size_t                   _running;
+    uint64_t                 _generation;
+    bool                     _quit;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,331 @@
+#include "H26xTsDemuxer.h"
+
+#include <cstring>
+
+#include "H26xUltis.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+constexpr size_t kTsPacketSize = 188;
+constexpr uint8_t kTsSyncByte = 0x47;
+
+static uint64_t ReadTimestamp(const uint8_t* data)
+{
+    // See also : ISO 13818/1(2019) - 2.4.3.7 Semantic definition of fields in PES packet (PTS/DTS)
+    return ((uint64_t)((data[0] >> 1) & 0x07) << 30) | ((uint64_t)data[1] << 22) | ((uint64_t)(data[2] >> 1) << 15) |
+           ((uint64_t)data[3] << 7) | (uint64_t)(data[4] >> 1);
+}
+
+H26xTsAccessUnit::H26xTsAccessUnit()
+{
+    pid = 0;
+    stream_type = 0;
+    random_access_indicator = 0;
+    PTS_DTS_flags = 0;
+    PTS = 0;
+    DTS = 0;
+    data = nullptr;
+    size = 0;
+}
+
+H26xTsDemuxer::H26xTsDemuxer(const AccessUnitCallback& callback)
+{
+    _callback = callback;
+    _packetSize = 0;
+    Reset();
+}
+
+void H26xTsDemuxer::Push(const uint8_t* data, size_t size)
+{
+    size_t pos = 0;
+    if (_packetSize)
+    {
+        size_t copyBytes = kTsPacketSize - _packetSize < size ? kTsPacketSize - _packetSize : size;
+        memcpy(_packet + _packetSize, data, copyBytes);
+        _packetSize += copyBytes;
+        pos += copyBytes;
+        if (_packetSize < kTsPacketSize)
+        {
+            return;
+        }
+        OnTsPacket(_packet);
+        _packetSize = 0;
+    }
+    while (pos < size)
+    {
+        if (data[pos] != kTsSyncByte)
+        {
+            // Hint : lost sync, search the next sync_byte
+            const uint8_t* sync = (const uint8_t*)memchr(data + pos, kTsSyncByte, size - pos);
+            if (!sync)
+            {
+                break;
+            }
+            pos = (size_t)(sync - data);
+            continue;
+        }
+        if (size - pos < kTsPacketSize)
+        {
+            memcpy(_packet, data + pos, size - pos);
+            _packetSize = size - pos;
+            break;
+        }
+        OnTsPacket(data + pos);
+        pos += kTsPacketSize;
+    }
+}
+
+void H26xTsDemuxer::Flush()
+{
+    for (auto& pes : _pes)
+    {
+        if (pes.second.started)
+        {
+            ReportPes(pes.second, pes.first);
+        }
+    }
+    _packetSize = 0;
+}
+
+void H26xTsDemuxer::Reset()
+{
+    _packetSize = 0;
+    _pes.clear();
+    _sections.clear();
+    SectionContext pat;
+    pat.started = false;
+    _sections[0x0000] = pat;
+}
+
+void H26xTsDemuxer::OnTsPacket(const uint8_t* packet)
+{
+    // See also : ISO 13818/1(2019) - 2.4.3.2 Transport stream packet layer
+    uint8_t  transport_error_indicator = (packet[1] >> 7) & 0x01;
+    uint8_t  payload_unit_start_indicator = (packet[1] >> 6) & 0x01;
+    uint16_t PID = (uint16_t)(((packet[1] & 0x1F) << 8) | packet[2]);
+    uint8_t  adaptation_field_control = (packet[3] >> 4) & 0x03;
+    uint8_t  continuity_counter = packet[3] & 0x0F;
+    uint8_t  random_access_indicator = 0;
+    size_t   pos = 4;
+    if (transport_error_indicator)
+    {
+        return;
+    }
+    if (adaptation_field_control & 0x02)
+    {
+        // See also : ISO 13818/1(2019) - 2.4.3.4 Adaptation field
+        uint8_t adaptation_field_length = packet[4];
+        if (adaptation_field_length > 0)
+        {
+            random_access_indicator = (packet[5] >> 6) & 0x01;
+        }
+        pos += 1 + adaptation_field_length;
+    }
+    if (!(adaptation_field_control & 0x01) || pos >= kTsPacketSize)
+    {
+        return;
+    }
+    if (_sections.count(PID))
+    {
+        OnSectionData(PID, payload_unit_start_indicator, packet + pos, kTsPacketSize - pos);
+        return;
+    }
+    auto it = _pes.find(PID);
+    if (it == _pes.end())
+    {
+        return;
+    }
+    PesContext& pes = it->second;
+    if (pes.continuityValid && continuity_counter != ((pes.continuity_counter + 1) & 0x0F))
+    {
+        if (continuity_counter == pes.continuity_counter)
+        {
+            // Hint : duplicate packet
+            return;
+        }
+        H26x_LOG_ERROR << "[TS] PID " << PID << " continuity_counter discontinuity, PES packet dropped" << H26x_LOG_TERMINATOR;
+        pes.started = false;
+        pes.buffer.clear();
+    }
+    pes.continuity_counter = continuity_counter;
+    pes.continuityValid = true;
+    if (payload_unit_start_indicator)
+    {
+        if (pes.started)
+        {
+            ReportPes(pes, PID);
+        }
+        pes.started = true;
+        pes.buffer.clear();
+        pes.PES_packet_length = 0;
+        pes.random_access_indicator = random_access_indicator;
+    }
+    OnPesData(pes, PID, packet + pos, kTsPacketSize - pos);
+}
+
+void H26xTsDemuxer::OnSectionData(uint16_t pid, bool payloadUnitStart, const uint8_t* data, size_t size)
+{
+    // See also : ISO 13818/1(2019) - 2.4.4 Program specific information
+    SectionContext& sec = _sections[pid];
+    auto processSections = [this, pid](SectionContext& sec) -> void
+    {
+        while (sec.started && sec.buffer.size() >= 3)
+        {
+            if (sec.buffer[0] == 0xFF) // stuffing
+            {
+                sec.started = false;
+                sec.buffer.clear();
+                break;
+            }
+            size_t sectionSize = 3 + (size_t)(((sec.buffer[1] & 0x0F) << 8) | sec.buffer[2]);
+            if (sec.buffer.size() < sectionSize)
+            {
+                break;
+            }
+            OnSection(pid, sec.buffer.data(), sectionSize);
+            sec.buffer.erase(sec.buffer.begin(), sec.buffer.begin() + sectionSize);
+        }
+    };
+    if (payloadUnitStart)
+    {
+        uint8_t pointer_field = data[0];
+        data++;
+        size--;
+        if (pointer_field > size)
+        {
+            sec.started = false;
+            sec.buffer.clear();
+            return;
+        }
+        // Hint : bytes in front of pointer_field end the previous section
+        if (sec.started)
+        {
+            sec.buffer.insert(sec.buffer.end(), data, data + pointer_field);
+            processSections(sec);
+        }
+        data += pointer_field;
+        size -= pointer_field;
+        sec.started = true;
+        sec.buffer.clear();
+    }
+    if (!sec.started)
+    {
+        return;
+    }
+    sec.buffer.insert(sec.buffer.end(), data, data + size);
+    processSections(sec);
+}
+
+void H26xTsDemuxer::OnSection(uint16_t pid, const uint8_t* section, size_t size)
+{
+    uint8_t table_id = section[0];
+    // Hint : 8 bytes of section header, 4 bytes of CRC_32
+    if (size < 12 || !(section[5] & 0x01) /* current_next_indicator */)
+    {
+        return;
+    }
+    if (table_id == 0x00 && pid == 0x0000)
+    {
+        // See also : ISO 13818/1(2019) - 2.4.4.4 Program association section
+        for (size_t i=8; i+4<=size-4; i+=4)
+        {
+            uint16_t program_number = (uint16_t)((section[i] << 8) | section[i+1]);
+            uint16_t program_map_PID = (uint16_t)(((section[i+2] & 0x1F) << 8) | section[i+3]);
+            if (program_number != 0 && !_sections.count(program_map_PID))
+            {
+                SectionContext pmt;
+                pmt.started = false;
+                _sections[program_map_PID] = pmt;
+            }
+        }
+    }
+    else if (table_id == 0x02 && size >= 16)
+    {
+        // See also : ISO 13818/1(2019) - 2.4.4.9 Program map section
+        size_t program_info_length = (size_t)(((section[10] & 0x0F) << 8) | section[11]);
+        for (size_t i=12+program_info_length; i+5<=size-4;)
+        {
+            uint8_t  stream_type = section[i];
+            uint16_t elementary_PID = (uint16_t)(((section[i+1] & 0x1F) << 8) | section[i+2]);
+            size_t   ES_info_length = (size_t)(((section[i+3] & 0x0F) << 8) | section[i+4]);
+            if ((stream_type == 0x1B /* H264 */ || stream_type == 0x24 /* H265 */) && !_pes.count(elementary_PID) && !_sections.count(elementary_PID))
+            {
+                PesContext pes;
+                pes.stream_type = stream_type;
+                pes.continuity_counter = 0;
+                pes.continuityValid = false;
+                pes.started = false;
+                pes.PES_packet_length = 0;
+                pes.random_access_indicator = 0;
+                _pes[elementary_PID] = pes;
+            }
+            i += 5 + ES_info_length;
+        }
+    }
+}
+
+void H26xTsDemuxer::OnPesData(PesContext& pes, uint16_t pid, const uint8_t* data, size_t size)
+{
+    if (!pes.started)
+    {
+        return;
+    }
+    size_t oldSize = pes.buffer.size();
+    pes.buffer.insert(pes.buffer.end(), data, data + size);
+    if (oldSize < 6 && pes.buffer.size() >= 6)
+    {
+        pes.PES_packet_length = (uint32_t)((pes.buffer[4] << 8) | pes.buffer[5]);
+    }
+    if (pes.PES_packet_length != 0 && pes.buffer.size() >= 6 + pes.PES_packet_length)
+    {
+        ReportPes(pes, pid);
+    }
+}
+
+void H26xTsDemuxer::ReportPes(PesContext& pes, uint16_t pid)
+{
+    // See also : ISO 13818/1(2019) - 2.4.3.6 PES packet
+    pes.started = false;
+    const uint8_t* data = pes.buffer.data();
+    size_t size = pes.buffer.size();
+    if (size < 9 || data[0] != 0x00 || data[1] != 0x00 || data[2] != 0x01)
+    {
+        H26x_LOG_ERROR << "[TS] PID " << pid << " invalid PES packet" << H26x_LOG_TERMINATOR;
+        return;
+    }
+    uint32_t PES_packet_length = (uint32_t)((data[4] << 8) | data[5]);
+    if (PES_packet_length != 0 && 6 + PES_packet_length < size)
+    {
+        size = 6 + PES_packet_length;
+    }
+    H26xTsAccessUnit au;
+    au.pid = pid;
+    au.stream_type = pes.stream_type;
+    au.random_access_indicator = pes.random_access_indicator;
+    au.PTS_DTS_flags = (data[7] >> 6) & 0x03;
+    uint8_t PES_header_data_length = data[8];
+    if (9 + (size_t)PES_header_data_length > size)
+    {
+        H26x_LOG_ERROR << "[TS] PID " << pid << " truncated PES header" << H26x_LOG_TERMINATOR;
+        return;
+    }
+    if ((au.PTS_DTS_flags & 0x02) && PES_header_data_length >= 5)
+    {
+        au.PTS = ReadTimestamp(data + 9);
+        au.DTS = au.PTS;
+    }
+    if (au.PTS_DTS_flags == 0x03 && PES_header_data_length >= 10)
+    {
+        au.DTS = ReadTimestamp(data + 14);
+    }
+    au.data = data + 9 + PES_header_data_length;
+    au.size = size - 9 - PES_header_data_length;
+    _callback(au);
+    pes.buffer.clear();
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,102 @@
+//
+// H26xTsDemuxer.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+//
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief H264/H265 access unit carried by one PES packet
+ * @sa    ISO 13818/1(2019) - 2.4.3.6 PES packet
+ */
+class H26xTsAccessUnit
+{
+public:
+    H26xTsAccessUnit();
+    ~H26xTsAccessUnit() = default;
+public:
+    uint16_t pid;
+    uint8_t  stream_type;             // 0x1B : H264, 0x24 : H265
+    uint8_t  random_access_indicator; // from adaptation field of the first TS packet
+    uint8_t  PTS_DTS_flags;           // 0b10 : PTS only (DTS = PTS), 0b11 : PTS and DTS
+    uint64_t PTS;                     // 90 kHz
+    uint64_t DTS;                     // 90 kHz
+    const uint8_t* data;              // byte stream (Annex B), valid during the callback only
+    size_t         size;
+};
+
+/**
+ * @brief MPEG-2 transport stream demuxer extracting H264/H265 elementary streams
+ * @note  1 - PAT and PMT are followed, PIDs with stream_type 0x1B (H264) and 0x24 (H265) are demuxed
+ *        2 - TS packets may be pushed in chunks of any size, sync is regained on 0x47 after garbage
+ *        3 - a PES packet is reported once the next one begins (PES_packet_length 0, as usual for video),
+ *            once PES_packet_length is reached, or on Flush(); PES payloads are reassembled into a buffer
+ *            per PID that is reused from one PES packet to the next
+ *        4 - a PES packet with a continuity_counter gap is dropped
+ *        5 - CRC_32 of PSI sections is not verified
+ * @sa    ISO 13818/1(2019) - 2.4 Transport stream bitstream requirements
+ */
+class H26xTsDemuxer
+{
+public:
+    using ptr = std::shared_ptr<H26xTsDemuxer>;
+    using AccessUnitCallback = std::function<void(const H26xTsAccessUnit& au)>;
+public:
+    explicit H26xTsDemuxer(const AccessUnitCallback& callback);
+    ~H26xTsDemuxer() = default;
+public:
+    void Push(const uint8_t* data, size_t size);
+    /**
+     * @brief end of transport stream, PES packets in progress are reported
+     */
+    void Flush();
+    void Reset();
+private:
+    class PesContext
+    {
+    public:
+        uint8_t              stream_type;
+        uint8_t              continuity_counter;
+        bool                 continuityValid;
+        bool                 started;   // PES header seen, payload being collected
+        uint32_t             PES_packet_length;
+        std::vector<uint8_t> buffer;    // whole PES packet, header included
+        uint8_t              random_access_indicator;
+    };
+    class SectionContext
+    {
+    public:
+        std::vector<uint8_t> buffer;
+        bool                 started;
+    };
+private:
+    void OnTsPacket(const uint8_t* packet);
+    void OnSectionData(uint16_t pid, bool payloadUnitStart, const uint8_t* data, size_t size);
+    void OnSection(uint16_t pid, const uint8_t* section, size_t size);
+    void OnPesData(PesContext& pes, uint16_t pid, const uint8_t* data, size_t size);
+    void ReportPes(PesContext& pes, uint16_t pid);
+private:
+    AccessUnitCallback _callback;
+    uint8_t            _packet[188];
+    size_t             _packetSize; // bytes of a TS packet split across chunks
+private:
+    std::map<uint16_t, SectionContext> _sections; // PAT and PMT PIDs
+    std::map<uint16_t, PesContext>     _pes;      // H264/H265 elementary stream PIDs
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -1,5 +1,20 @@
 #include "H26xUltis.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif /* _MSC_VER */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MMP_H26X_USE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define MMP_H26X_USE_AVX2
+#include <immintrin.h>
+#endif
+
+#include <cstring>
+
 #include "H264Common.h"
 
 namespace Mmp
@@ -47,5 +62,86 @@ std::string H264SliceTypeToStr(uint8_t slice_type)
     }
 }
 
+static inline uint32_t CountTrailingZero32(uint32_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctz(value);
+#endif
+}
+
+size_t H26xFindZeroZeroByte(const uint8_t* data, size_t pos, size_t size, uint8_t third)
+{
+#if defined(MMP_H26X_USE_AVX2)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i xx = _mm256_set1_epi8((char)third);
+        for (; pos + 34 <= size; pos += 32)
+        {
+            __m256i b0 = _mm256_loadu_si256((const __m256i*)(data + pos));
+            __m256i b1 = _mm256_loadu_si256((const __m256i*)(data + pos + 1));
+            __m256i b2 = _mm256_loadu_si256((const __m256i*)(data + pos + 2));
+            __m256i hit = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(b0, zero), _mm256_cmpeq_epi8(b1, zero)), _mm256_cmpeq_epi8(b2, xx));
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+            if (mask)
+            {
+                return pos + CountTrailingZero32(mask);
+            }
+        }
+    }
+#endif /* MMP_H26X_USE_AVX2 */
+#if defined(MMP_H26X_USE_SSE2)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i xx = _mm_set1_epi8((char)third);
+        for (; pos + 18 <= size; pos += 16)
+        {
+            __m128i b0 = _mm_loadu_si128((const __m128i*)(data + pos));
+            __m128i b1 = _mm_loadu_si128((const __m128i*)(data + pos + 1));
+            __m128i b2 = _mm_loadu_si128((const __m128i*)(data + pos + 2));
+            __m128i hit = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(b0, zero), _mm_cmpeq_epi8(b1, zero)), _mm_cmpeq_epi8(b2, xx));
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+            if (mask)
+            {
+                return pos + CountTrailingZero32(mask);
+            }
+        }
+    }
+#endif /* MMP_H26X_USE_SSE2 */
+    for (; pos + 3 <= size; pos++)
+    {
+        if (data[pos + 2] == third && data[pos + 1] == 0 && data[pos] == 0)
+        {
+            return pos;
+        }
+    }
+    return size;
+}
+
+uint64_t H26xHash(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i=0; i<size; i++)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+H26xParameterSetData::H26xParameterSetData(const uint8_t* nalData, size_t nalSize, uint64_t nalHash)
+{
+    hash = nalHash;
+    data.assign(nalData, nalData + nalSize);
+}
+
+bool H26xParameterSetData::Equal(const uint8_t* nalData, size_t nalSize, uint64_t nalHash)
+{
+    return hash == nalHash && data.size() == nalSize && (nalSize == 0 || memcmp(data.data(), nalData, nalSize) == 0);
+}
+
 } // namespace Codec
 } // namespace Mmp
\ No newline at end of file
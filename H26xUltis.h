@@ -10,6 +10,10 @@
 
 #include <iostream>
 #include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
 
 #ifdef MMP_H26x_EXTERN_HEADER
 #include MMP_H26x_EXTERN_HEADER
@@ -55,10 +59,51 @@ namespace Codec
                                                                     }
 #endif /* MMP_H26X_DEBUG_MODE */
 
+// Hint : with MMP_H26X_NO_EXCEPTIONS (-fno-exceptions) try/catch is not available, H26xBinaryReader sets
+//        its sticky error flag instead of throwing, and syntax structures check H26xBinaryReader::Error()
+#ifndef MMP_H26X_NO_EXCEPTIONS
+#define MMP_H26X_TRY                                                try
+#define MMP_H26X_CATCH(exception)                                   catch (exception)
+#else
+#define MMP_H26X_TRY                                                if (true)
+#define MMP_H26X_CATCH(exception)                                   else if (false)
+#endif /* MMP_H26X_NO_EXCEPTIONS */
+
 std::string H264NaluTypeToStr(uint8_t nal_unit_type);
 
 std::string H264SliceTypeToStr(uint8_t slice_type);
 
+/**
+ * @brief find the first 0x0000XX (XX = third) in [pos, size), e.g. start code (0x01)
+ *        or emulation_prevention_three_byte (0x03)
+ * @return offset of the first zero byte of the pattern, size if not found
+ * @note   SSE2/AVX2 are used when available
+ */
+size_t H26xFindZeroZeroByte(const uint8_t* data, size_t pos, size_t size, uint8_t third);
+
+/**
+ * @brief 64 bit FNV-1a hash of data, such as a parameter set NAL unit
+ */
+uint64_t H26xHash(const uint8_t* data, size_t size);
+
+/**
+ * @brief NAL unit (without start code) a parameter set is deserialized from
+ * @note  byte identical parameter sets are deserialized once, the hash is compared first
+ */
+class H26xParameterSetData
+{
+public:
+    using ptr = std::shared_ptr<H26xParameterSetData>;
+public:
+    H26xParameterSetData(const uint8_t* nalData, size_t nalSize, uint64_t nalHash);
+    ~H26xParameterSetData() = default;
+public:
+    bool Equal(const uint8_t* nalData, size_t nalSize, uint64_t nalHash);
+public:
+    uint64_t             hash;   // H26xHash(data)
+    std::vector<uint8_t> data;
+};
+
 
 } // namespace Codec
 } // namespace Mmp
\ No newline at end of file
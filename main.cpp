@@ -10,6 +10,9 @@
 
 #include "AbstractH26xByteReader.h"
 #include "H26xBinaryReader.h"
+#include "H26xMmapByteReader.h"
+#include "H26xAsyncByteReader.h"
+#include "H26xTsDemuxer.h"
 #include "H264Deserialize.h"
 #include "H265Deserialize.h"
 
@@ -99,7 +102,7 @@ private:
     std::ifstream _ifs;
 private:
     uint8_t* _buf;
-    uint32_t _offset;
+    uint64_t _offset;
     uint32_t _cur;
     uint32_t _len;
 };
@@ -113,7 +116,7 @@ CacheFileH264ByteReader::CacheFileH264ByteReader(const std::string& h264Path)
         exit(255);
     }
     _buf = new uint8_t[kBufSize];
-    _offset = _ifs.tellg();
+    _offset = 0;
     _ifs.read((char*)_buf, kBufSize);
     _cur = 0;
     _len = _ifs.gcount();
@@ -127,58 +130,48 @@ CacheFileH264ByteReader::~CacheFileH264ByteReader()
 
 size_t CacheFileH264ByteReader::Read(void* data, size_t bytes)
 {
-    if (_cur + bytes < _len)
+    size_t readBytes = 0;
+    while (readBytes < bytes)
     {
-        memcpy(data, _buf + _cur, bytes);
-        _cur += bytes;
-        return bytes;
-    }
-    else if (_ifs.eof())
-    {
-        memcpy(data, _buf + _cur, _len -  _cur);
-        return _len -  _cur;
-    }
-    else
-    {
-        _offset = _ifs.tellg();
-        _ifs.readsome((char*)_buf, kBufSize);
-        _cur = 0;
-        _len = _ifs.gcount(); 
-        if (_len == 0) /* eof */
+        if (_cur == _len)
         {
-            return 0;
-        }
-        else
-        {
-            return Read(data, bytes);
+            if (_ifs.eof())
+            {
+                break;
+            }
+            _offset += _len;
+            _ifs.read((char*)_buf, kBufSize);
+            _cur = 0;
+            _len = _ifs.gcount();
+            if (_len == 0) /* eof */
+            {
+                break;
+            }
         }
+        size_t copyBytes = (bytes - readBytes) < (_len - _cur) ? (bytes - readBytes) : (_len - _cur);
+        memcpy((uint8_t*)data + readBytes, _buf + _cur, copyBytes);
+        _cur += copyBytes;
+        readBytes += copyBytes;
     }
+    return readBytes;
 }
 
 bool CacheFileH264ByteReader::Seek(size_t offset)
 {
-    if (offset < _offset)
+    if (offset >= _offset && offset <= _offset + _len)
     {
-        _ifs.seekg(offset);
-        _offset = _ifs.tellg();
-        _ifs.readsome((char*)_buf, kBufSize);
-        _cur = 0;
-        _len = _ifs.gcount(); 
-        return _offset == offset;
+        _cur = offset - _offset;
+        return true;
     }
-    else if (offset > _offset + kBufSize)
+    else
     {
+        _ifs.clear();
         _ifs.seekg(offset);
-        _offset = _ifs.tellg();
-        _ifs.readsome((char*)_buf, kBufSize);
+        _offset = offset;
+        _ifs.read((char*)_buf, kBufSize);
         _cur = 0;
-        _len = _ifs.gcount(); 
-        return _offset == offset;
-    }
-    else
-    {
-        _cur = offset - _offset;
-        return true;
+        _len = _ifs.gcount();
+        return _len != 0;
     }
 }
 
@@ -263,72 +256,140 @@ static std::string H265NalUintTypeToStr(uint32_t nal_unit_type)
     }
 }
 
+static bool EndsWith(const std::string& str, const std::string& suffix)
+{
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static bool IsTransportStream(const std::string& path)
+{
+    return EndsWith(path, ".ts") || EndsWith(path, ".m2ts");
+}
+
 void Usage()
 {
     std::stringstream ss;
-    ss << "[usage] ./Sample [xxx.h264 | xxx.h265]" << std::endl;
+    ss << "[usage] ./Sample [xxx.h264 | xxx.h265 | xxx.ts | xxx.m2ts]" << std::endl;
     std::cout << ss.str() << std::endl;
 }
 
 int main(int argc, char* argv[])
 {
-    if (argc != 2 || (std::string(argv[1]).find(".h264") == std::string::npos && std::string(argv[1]).find(".h265") == std::string::npos))
+    if (argc != 2 || (std::string(argv[1]).find(".h264") == std::string::npos && std::string(argv[1]).find(".h265") == std::string::npos
+        && !IsTransportStream(argv[1])))
     {
         Usage();
         return -1;
     }
+    if (IsTransportStream(argv[1]))
+    {
+        H26xMmapByteReader::ptr mmapReader = std::make_shared<H26xMmapByteReader>(std::string(argv[1]));
+        if (!mmapReader->IsOpen())
+        {
+            return -1;
+        }
+        H264Deserialize::ptr h264Deserialize = std::make_shared<H264Deserialize>();
+        H265Deserialize::ptr h265Deserialize = std::make_shared<H265Deserialize>();
+        int num = 0;
+        auto begin = std::chrono::system_clock::now();
+        H26xTsDemuxer::ptr demuxer = std::make_shared<H26xTsDemuxer>([&](const H26xTsAccessUnit& au) -> void
+        {
+            std::cout << "[pid " << au.pid << "]" << " pts : " << au.PTS << " dts : " << au.DTS;
+            if (au.stream_type == 0x1B)
+            {
+                std::vector<H264NalSyntax::ptr> nals;
+                h264Deserialize->DeserializeByteStream(au.data, au.size, nals);
+                for (const auto& nal : nals)
+                {
+                    std::cout << " [" << H264NalUintTypeToStr(nal->nal_unit_type) << "]";
+                }
+                num += (int)nals.size();
+            }
+            else
+            {
+                std::vector<H265NalSyntax::ptr> nals;
+                h265Deserialize->DeserializeByteStream(au.data, au.size, nals);
+                for (const auto& nal : nals)
+                {
+                    std::cout << " [" << (nal->header ? H265NalUintTypeToStr(nal->header->nal_unit_type) : "unknown") << "]";
+                }
+                num += (int)nals.size();
+            }
+            std::cout << std::endl;
+        });
+        demuxer->Push(mmapReader->Data(), mmapReader->Size());
+        demuxer->Flush();
+        std::chrono::duration<double> cost = std::chrono::system_clock::now() - begin;
+        std::cout << "total cost time : " << (uint64_t)(cost.count() * 1000) << "ms"
+                  << " (" << (uint64_t)(num / cost.count()) << " NAL/s)" << std::endl;
+        return 0;
+    }
 #if 0 /* slow but simple */
     AbstractH26xByteReader::ptr byteReader = std::make_shared<SimpleFileH264ByteReader>(std::string(argv[1]));
-#else /* fast but a bit complicated  */
+#elif 0 /* fast but a bit complicated  */
     AbstractH26xByteReader::ptr byteReader = std::make_shared<CacheFileH264ByteReader>(std::string(argv[1]));
+#elif 0 /* asynchronous read ahead, provided by library */
+    H26xAsyncByteReader::ptr asyncReader = std::make_shared<H26xAsyncByteReader>(std::string(argv[1]));
+    if (!asyncReader->IsOpen())
+    {
+        return -1;
+    }
+    AbstractH26xByteReader::ptr byteReader = asyncReader;
+#else /* memory mapped, provided by library */
+    H26xMmapByteReader::ptr mmapReader = std::make_shared<H26xMmapByteReader>(std::string(argv[1]));
+    if (!mmapReader->IsOpen())
+    {
+        return -1;
+    }
+    AbstractH26xByteReader::ptr byteReader = mmapReader;
 #endif
     if (std::string(argv[1]).find(".h264") != std::string::npos)
     {
         H26xBinaryReader::ptr binaryReader = std::make_shared<H26xBinaryReader>(byteReader);
         H264Deserialize::ptr deserialize = std::make_shared<H264Deserialize>();
-        std::vector<H264NalSyntax::ptr> nals;
+        // Hint : NAL units are released once printed, the pool recycles them
+        H264SyntaxPool::ptr pool = std::make_shared<H264SyntaxPool>();
+        deserialize->SetSyntaxPool(pool);
         bool res = true;
         int num = 0;
         auto begin = std::chrono::system_clock::now();
         do
         {
             num++;
-            H264NalSyntax::ptr nal = std::make_shared<H264NalSyntax>();
+            H264NalSyntax::ptr nal = pool->AcquireNalSyntax();
             auto start = std::chrono::system_clock::now();
             res = deserialize->DeserializeByteStreamNalUnit(binaryReader, nal);
             std::cout << "(" << num << ")" << "  "  << "[" << H264NalUintTypeToStr(nal->nal_unit_type) << "]" 
                     << " cost time :" << (std::chrono::system_clock::now() - start).count() / (1000 * 1000) << " ms"
                     << std::endl;
-            if (res)
-            {
-                nals.push_back(nal);
-            }
         } while (res && !binaryReader->Eof());
-        std::cout << "total cost time : " << (std::chrono::system_clock::now() - begin).count() / (1000 * 1000) << "ms";
+        std::chrono::duration<double> cost = std::chrono::system_clock::now() - begin;
+        std::cout << "total cost time : " << (uint64_t)(cost.count() * 1000) << "ms"
+                  << " (" << (uint64_t)(num / cost.count()) << " NAL/s)" << std::endl;
     }
     else if (std::string::npos && std::string(argv[1]).find(".h265") != std::string::npos)
     {
         H26xBinaryReader::ptr binaryReader = std::make_shared<H26xBinaryReader>(byteReader);
         H265Deserialize::ptr deserialize = std::make_shared<H265Deserialize>();
-        std::vector<H265NalSyntax::ptr> nals;
+        // Hint : NAL units are released once printed, the pool recycles them
+        H265SyntaxPool::ptr pool = std::make_shared<H265SyntaxPool>();
+        deserialize->SetSyntaxPool(pool);
         bool res = true;
         int num = 0;
         auto begin = std::chrono::system_clock::now();
         do
         {
             num++;
-            H265NalSyntax::ptr nal = std::make_shared<H265NalSyntax>();
+            H265NalSyntax::ptr nal = pool->AcquireNalSyntax();
             auto start = std::chrono::system_clock::now();
             res = deserialize->DeserializeByteStreamNalUnit(binaryReader, nal);
             std::cout << "(" << num << ")" << "  "  << "[" << H265NalUintTypeToStr(nal->header->nal_unit_type) << "]" 
                     << " cost time :" << (std::chrono::system_clock::now() - start).count() / (1000 * 1000) << " ms"
                     << std::endl;
-            if (res)
-            {
-                nals.push_back(nal);
-            }
         } while (res && !binaryReader->Eof());
-        std::cout << "total cost time : " << (std::chrono::system_clock::now() - begin).count() / (1000 * 1000) << "ms";
+        std::chrono::duration<double> cost = std::chrono::system_clock::now() - begin;
+        std::cout << "total cost time : " << (uint64_t)(cost.count() * 1000) << "ms"
+                  << " (" << (uint64_t)(num / cost.count()) << " NAL/s)" << std::endl;
     }
 
     return 0;